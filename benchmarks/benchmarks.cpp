@@ -0,0 +1,32 @@
+#include "benchmarks.hpp"
+
+#include <cstdlib>  // atol
+#include <cstring>  // strcmp
+#include <iomanip>  // std::setw
+
+size_t bench_count = 1000000;
+
+size_t alloc_stats::allocations = 0;
+size_t alloc_stats::current_bytes = 0;
+size_t alloc_stats::peak_bytes = 0;
+
+void start_bench(const char *bench_name, void (*func)(void)) {
+  std::cout << "------------------- " << bench_name << "        -------------------\n";
+  func();
+  std::cout << "------------------- End Of " << bench_name << " -------------------\n";
+}
+
+void report(const std::string &label, size_t ops, double ms) {
+  std::cout << std::left << std::setw(52) << label << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ms << " ms"
+            << std::setw(12) << (ms > 0 ? ops / ms / 1000.0 : 0) << " Mops/s\n";
+}
+
+// usage: ./bench [suite|all] [count]
+int main(int argc, char **argv) {
+  const char *suite = argc > 1 ? argv[1] : "all";
+  if (argc > 2) bench_count = atol(argv[2]);
+
+  std::cout << "element count: " << bench_count << '\n';
+  if (!strcmp(suite, "all") || !strcmp(suite, "vector")) start_bench("vector benchmarks", vector_bench);
+  if (!strcmp(suite, "all") || !strcmp(suite, "map")) start_bench("map benchmarks", map_bench);
+}
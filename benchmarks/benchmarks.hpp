@@ -0,0 +1,93 @@
+#ifndef __BENCHMARKS_HPP__
+#define __BENCHMARKS_HPP__
+
+#include <sys/time.h>
+
+#include <cstddef>   // size_t
+#include <cstdlib>   // rand
+#include <iostream>  // std::cout
+#include <memory>    // std::allocator
+#include <string>    // std::string
+
+#include "map.hpp"
+#include "multimap.hpp"
+#include "multiset.hpp"
+#include "set.hpp"
+#include "stack.hpp"
+#include "vector.hpp"
+
+// benchmarks are ft only (they measure ft specific knobs), each suite compares against the std container
+// or against the previous ft strategy when there's no std equivalent.
+
+class bench_timer {
+  struct timeval _start;
+
+ public:
+  bench_timer() { this->reset(); }
+
+  void reset(void) { gettimeofday(&this->_start, NULL); }
+
+  // elapsed time in milliseconds since the construction or the last reset
+  double elapsed(void) const {
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - this->_start.tv_sec) * 1000.0 + (now.tv_usec - this->_start.tv_usec) / 1000.0;
+  }
+};
+
+// allocation counters shared by every counting_allocator
+struct alloc_stats {
+  static size_t allocations;
+  static size_t current_bytes;
+  static size_t peak_bytes;
+
+  static void reset(void) { allocations = current_bytes = peak_bytes = 0; }
+};
+
+// std::allocator that records the number of allocations & the peak of allocated bytes
+template <class T>
+class counting_allocator : public std::allocator<T> {
+ public:
+  typedef typename std::allocator<T>::size_type size_type;
+  typedef typename std::allocator<T>::pointer   pointer;
+
+  template <class U>
+  struct rebind {
+    typedef counting_allocator<U> other;
+  };
+
+  counting_allocator() {}
+  template <class U>
+  counting_allocator(const counting_allocator<U> &copy) : std::allocator<T>(copy) {}
+
+  pointer allocate(size_type n, const void *hint = 0) {
+    (void)hint;
+    alloc_stats::allocations++;
+    alloc_stats::current_bytes += n * sizeof(T);
+    if (alloc_stats::current_bytes > alloc_stats::peak_bytes) alloc_stats::peak_bytes = alloc_stats::current_bytes;
+    return std::allocator<T>::allocate(n);
+  }
+
+  void deallocate(pointer p, size_type n) {
+    alloc_stats::current_bytes -= n * sizeof(T);
+    std::allocator<T>::deallocate(p, n);
+  }
+};
+
+// the base element count of the suites, can be changed from the command line
+extern size_t bench_count;
+
+void start_bench(const char *bench_name, void (*func)(void));
+void report(const std::string &label, size_t ops, double ms);
+
+// keep the optimizer from removing the benchmarked work
+template <typename T>
+void do_not_optimize(const T &value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
+
+void vector_bench(void);
+void map_bench(void);
+
+#endif
@@ -5,18 +5,27 @@
 #include <memory>
 
 #include "equal.hpp"
+#include "functional.hpp"
 #include "iterator_traits.hpp"
 #include "lexicographical_compare.hpp"
+#include "move.hpp"
 #include "pair.hpp"
 #include "red_black_tree.hpp"
+#include "thread_pool.hpp"
 
 // Todo: add virtual destructor !
 
 namespace ft {
-template <class Key,                                         // map::key_type
-          class T,                                           // map::mapped_type
-          class Compare = std::less<Key>,                    // map::key_compare
-          class Alloc = std::allocator<pair<const Key, T> >  // map::allocator_type
+
+// with an augmented NodePolicy (ft::counted_node keeps its counts, ft::augmented_node summarizes the mapped values),
+// the summaries follow insert, erase & insert_or_assign. a mapped value changed in place, through operator[],
+// an iterator or a reference (ex: the iterator returned by try_emplace), leaves the summaries above it stale :
+// call refresh(iterator) after the change, or aggregate() returns the old values.
+template <class Key,                                          // map::key_type
+          class T,                                            // map::mapped_type
+          class Compare = std::less<Key>,                     // map::key_compare
+          class Alloc = std::allocator<pair<const Key, T> >,  // map::allocator_type
+          class NodePolicy = ft::compact_node                 // layout of the tree nodes (see node_policy.hpp)
           >
 class map {
  public:
@@ -33,8 +42,8 @@ class map {
   typedef typename allocator_type::const_pointer   const_pointer;
 
  private:
-  typedef RedBlackTree<value_type, value_compare, allocator_type> RBT;
-  RBT                                                             tree;
+  typedef RedBlackTree<key_type, value_type, ft::select_first<value_type>, key_compare, allocator_type, NodePolicy> RBT;
+  RBT                                                                               tree;
   allocator_type                                                  _alloc;
   key_compare                                                     _key_comp;
   value_compare                                                   _value_comp;
@@ -46,6 +55,9 @@ class map {
   typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
   typedef typename allocator_type::difference_type difference_type;
   typedef typename allocator_type::size_type       size_type;
+  // a node taken out of the map by extract, to go into a map by insert without being copied (see node_handle.hpp)
+  typedef ft::map_node_handle<typename RBT::node_type, typename RBT::node_alloc, key_type, mapped_type> node_type;
+  typedef ft::insert_return_type<iterator, node_type>                                                   insert_return_type;
 
  public:
   // the default constructor
@@ -72,6 +84,19 @@ class map {
     return *this;
   }
 
+#if FT_CXX11
+  // move constructor
+  map(map&& x) : tree(std::move(x.tree)), _alloc(x._alloc), _key_comp(x._key_comp), _value_comp(x._value_comp) {}
+
+  // move assignment operator
+  map& operator=(map&& x) {
+    if (this != &x) {
+      this->tree = std::move(x.tree);
+    }
+    return *this;
+  }
+#endif
+
   // Iterators
   iterator       begin() { return tree.begin(); };
   const_iterator begin() const { return tree.begin(); };
@@ -91,46 +116,179 @@ class map {
   size_type max_size() const { return tree.max_size(); };
 
   // Element access
-  mapped_type& operator[](const key_type& k) { return (*((this->insert(ft::make_pair(k, mapped_type()))).first)).second; }
+  // an existing key builds nothing, a new one builds its mapped value once in its node
+  mapped_type& operator[](const key_type& k) { return (*this->try_emplace_with(k, ft::default_value<mapped_type>()).first).second; }
+
+#if FT_CXX11
+  mapped_type& operator[](key_type&& k) { return mappedOf(tree.tryEmplaceUnique(nullptr, std::move(k), ft::default_value<mapped_type>()).second); }
+#endif
 
   // Modifiers
 
   pair<iterator, bool> insert(const value_type& val) {
-    ft::pair<bool, typename RBT::pointer> ret = tree.insertUnique(val);
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUnique(val);
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  // linked next to the hint without a descent when the value goes right before or right after it
+  iterator insert(iterator position, const value_type& val) { return iterator(tree.insertUnique(position.base(), val).second); }
+
+#if FT_CXX11
+  pair<iterator, bool> insert(value_type&& val) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUnique(std::move(val));
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  iterator insert(iterator position, value_type&& val) { return iterator(tree.insertUnique(position.base(), std::move(val)).second); }
+
+  template <class... Args>
+  pair<iterator, bool> emplace(Args&&... args) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.emplaceUnique(std::forward<Args>(args)...);
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator position, Args&&... args) {
+    return iterator(tree.emplaceHintUnique(position.base(), std::forward<Args>(args)...).second);
+  }
+#endif
+
+  // the element of the key `k` when it's there (nothing is built), otherwise a new element whose mapped value is built
+  // once in place from make() (ex: ft::default_value, ft::copy_value, or a functor of the caller)
+  template <class Factory>
+  pair<iterator, bool> try_emplace_with(const key_type& k, Factory make) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, k, make);
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class Factory>
+  iterator try_emplace_with(iterator position, const key_type& k, Factory make) {
+    return iterator(tree.tryEmplaceUnique(position.base(), k, make).second);
+  }
+
+#if FT_CXX11
+  // the same, the mapped value is built from `args` (the arguments aren't touched when the key is there)
+  template <class... Args>
+  pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, k, [&]() { return mapped_type(std::forward<Args>(args)...); });
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class... Args>
+  pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, std::move(k), [&]() { return mapped_type(std::forward<Args>(args)...); });
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class... Args>
+  iterator try_emplace(iterator position, const key_type& k, Args&&... args) {
+    return iterator(tree.tryEmplaceUnique(position.base(), k, [&]() { return mapped_type(std::forward<Args>(args)...); }).second);
+  }
+
+  template <class... Args>
+  iterator try_emplace(iterator position, key_type&& k, Args&&... args) {
+    return iterator(tree.tryEmplaceUnique(position.base(), std::move(k), [&]() { return mapped_type(std::forward<Args>(args)...); }).second);
+  }
+
+  // `obj` is assigned to the mapped value of an existing key, or builds the mapped value of a new one
+  template <class M>
+  pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, k, [&]() -> M&& { return std::forward<M>(obj); });
+
+    if (!ret.first) this->assignMapped(ret.second, std::forward<M>(obj));
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class M>
+  pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, std::move(k), [&]() -> M&& { return std::forward<M>(obj); });
+
+    if (!ret.first) this->assignMapped(ret.second, std::forward<M>(obj));
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class M>
+  iterator insert_or_assign(iterator position, const key_type& k, M&& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(position.base(), k, [&]() -> M&& { return std::forward<M>(obj); });
+
+    if (!ret.first) this->assignMapped(ret.second, std::forward<M>(obj));
+    return iterator(ret.second);
+  }
+
+  template <class M>
+  iterator insert_or_assign(iterator position, key_type&& k, M&& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(position.base(), std::move(k), [&]() -> M&& { return std::forward<M>(obj); });
+
+    if (!ret.first) this->assignMapped(ret.second, std::forward<M>(obj));
+    return iterator(ret.second);
+  }
+#else
+  // `obj` is assigned to the mapped value of an existing key, or builds the mapped value of a new one
+  template <class M>
+  pair<iterator, bool> insert_or_assign(const key_type& k, const M& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(nullptr, k, ft::copy_value<M>(obj));
 
+    if (!ret.first) this->assignMapped(ret.second, obj);
     return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
   }
 
-  iterator insert(iterator position, const value_type& val) {
-    (void)position;  // i don't use hint in my implementation
-    return this->insert(val).first;
+  template <class M>
+  iterator insert_or_assign(iterator position, const key_type& k, const M& obj) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.tryEmplaceUnique(position.base(), k, ft::copy_value<M>(obj));
+
+    if (!ret.first) this->assignMapped(ret.second, obj);
+    return iterator(ret.second);
   }
+#endif
 
+  // sorted ranges are built in O(n) in an empty container, or linked without descents (each value hinted with the previous one)
   template <class InputIterator>
   void insert(InputIterator first, InputIterator last) {
-    while (first != last) {
-      this->insert(*first);
-      first++;
-    }
+    tree.insertUniqueRange(first, last);
   }
 
-  void      erase(iterator position) { tree.deleteNode(*position); }
-  size_type erase(const key_type& k) { return tree.deleteNode(value_type(k, mapped_type())); }
-  void      erase(iterator first, iterator last) {
-    while (first != last) {
-      iterator tmp(first);
-      tmp++;
-      this->erase(first);
-      first = tmp;
-    }
+  // the same, a sorted random access range is built on the threads of the pool in an empty container (see thread_pool.hpp)
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last, ft::thread_pool& pool) {
+    tree.insertUniqueRange(first, last, pool);
   }
 
-  void swap(map& x) {
-    RBT tmp(x.tree);
+  // the iterator erasures unlink their nodes directly, without searching them
+  void      erase(iterator position) { tree.eraseNode(position.base()); }
+  size_type erase(const key_type& k) { return tree.deleteNode(k); }
+  void      erase(iterator first, iterator last) { tree.eraseRange(first.base(), last.base()); }
 
-    x.tree = this->tree;
-    this->tree = tmp;
-    // std::swap(this->tree, x.tree); // this would be better than above !!
+  // the node of the element leaves the map in the handle, an empty handle when the key isn't there
+  node_type extract(iterator position) { return tree.template extractNode<node_type>(position.base()); }
+  node_type extract(const key_type& k) {
+    iterator it = this->find(k);
+
+    return it == this->end() ? node_type() : this->extract(it);
+  }
+
+  // the node of the handle is linked as it is when its key isn't here, it's given back in the result otherwise
+  insert_return_type insert(node_type nh) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUniqueNode(nh);
+    insert_return_type                     result;
+
+    result.position = iterator(ret.second);
+    result.inserted = ret.first;
+    result.node = FT_MOVE(nh);
+    return result;
+  }
+
+  // constant time, no element is copied or moved
+  void swap(map& x) {
+    this->tree.swap(x.tree);
+    std::swap(this->_alloc, x._alloc);
+    std::swap(this->_key_comp, x._key_comp);
+    std::swap(this->_value_comp, x._value_comp);
   }
 
   void clear() { tree.clear(); }
@@ -141,31 +299,99 @@ class map {
 
   // Operations
 
-  iterator find(const key_type& k) {
-    typename RBT::pointer exists = tree.find(value_type(k, mapped_type()));
+  iterator       find(const key_type& k) { return tree.find(k); }
+  const_iterator find(const key_type& k) const { return tree.find(k); }
+
+  size_type count(const key_type& k) const { return this->find(k) != this->end(); }
+
+  iterator       lower_bound(const key_type& k) { return tree.lower_bound(k); }
+  const_iterator lower_bound(const key_type& k) const { return tree.lower_bound(k); }
+
+  iterator       upper_bound(const key_type& k) { return tree.upper_bound(k); }
+  const_iterator upper_bound(const key_type& k) const { return tree.upper_bound(k); }
+
+  ft::pair<iterator, iterator>             equal_range(const key_type& k) { return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+  ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
 
-    if (exists->isNil()) return this->end();
+  // the iterator of each key of [first, last) (or the end), written to `out` in the order of the keys : the descents
+  // of several keys are interleaved & prefetch their next node, the lookups of a large map wait less on the memory
+  template <class ForwardIterator, class OutputIterator>
+  OutputIterator find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+    return tree.findMany(first, last, out);
+  }
 
-    return iterator(exists);
+  // heterogeneous lookups, only with a transparent comparator (declaring `is_transparent`) :
+  // the key is compared as it is, ex: a std::string key with a const char * without building a std::string
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type find(const K& k) {
+    return tree.find(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type find(const K& k) const {
+    return tree.find(k);
   }
-  const_iterator find(const key_type& k) const {
-    typename RBT::pointer exists = tree.find(value_type(k, mapped_type()));
 
-    if (exists->isNil()) return this->end();
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, size_type>::type count(const K& k) const {
+    return tree.find(k) != tree.end();
+  }
 
-    return const_iterator(exists);
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type lower_bound(const K& k) {
+    return tree.lower_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type lower_bound(const K& k) const {
+    return tree.lower_bound(k);
   }
 
-  size_type count(const key_type& k) const { return this->find(k) != this->end(); }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type upper_bound(const K& k) {
+    return tree.upper_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type upper_bound(const K& k) const {
+    return tree.upper_bound(k);
+  }
 
-  iterator       lower_bound(const key_type& k) { return tree.lower_bound(value_type(k, mapped_type())); }
-  const_iterator lower_bound(const key_type& k) const { return tree.lower_bound(value_type(k, mapped_type())); }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+    return ft::pair<iterator, iterator>(tree.lower_bound(k), tree.upper_bound(k));
+  }
 
-  iterator       upper_bound(const key_type& k) { return tree.upper_bound(value_type(k, mapped_type())); }
-  const_iterator upper_bound(const key_type& k) const { return tree.upper_bound(value_type(k, mapped_type())); }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+    return ft::pair<const_iterator, const_iterator>(tree.lower_bound(k), tree.upper_bound(k));
+  }
 
-  ft::pair<iterator, iterator>             equal_range(const key_type& k) { return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
-  ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
+  // order statistics, only with a NodePolicy counting the nodes (ft::counted_node) : O(log n) without walking the elements
+  iterator        nth(size_type k) { return tree.nth(k); }
+  const_iterator  nth(size_type k) const { return tree.nth(k); }
+  size_type       rank(const key_type& k) const { return tree.rank(k); }  // the number of keys less than k
+  difference_type distance(const_iterator first, const_iterator last) const { return tree.distance(first.base(), last.base()); }
+
+  // range aggregates, only with a NodePolicy summarizing the values by a monoid (ft::augmented_node) :
+  // the combination of the values whose key is in [lo, hi), in O(log n)
+  typedef typename RBT::summary_type summary_type;
+
+  summary_type aggregate(const key_type& lo, const key_type& hi) const { return tree.aggregate(lo, hi); }
+
+  // the summaries follow the insertions, the erasures & insert_or_assign, a mapped value changed in place must be
+  // refreshed (O(log n)) : m[k] += x; m.refresh(m.find(k));
+  void refresh(iterator position) { tree.pullPath(position.base()); }
+
+  // set algebra by splitting & joining the trees : O(m log(n/m + 1)) for m <= n elements, the nodes move from tree
+  // to tree (no element is copied, unless the allocators can't share their nodes)
+  void merge(map& x) { tree.merge(x.tree); }                           // the elements of x whose key isn't here move here, the others stay in x
+  void set_union(map& x) { tree.unionWith(x.tree); }                   // x is left empty, the elements here win over the equal ones of x
+  void set_intersection(const map& x) { tree.intersectWith(x.tree); }  // the elements here whose key is in x
+  void set_difference(const map& x) { tree.subtract(x.tree); }         // the elements here whose key isn't in x
+
+  // the same on the threads of the pool : both sides of each split go to two threads, down to the grain of the pool
+  void merge(map& x, ft::thread_pool& pool) { tree.merge(x.tree, &pool); }
+  void set_union(map& x, ft::thread_pool& pool) { tree.unionWith(x.tree, &pool); }
+  void set_intersection(const map& x, ft::thread_pool& pool) { tree.intersectWith(x.tree, &pool); }
+  void set_difference(const map& x, ft::thread_pool& pool) { tree.subtract(x.tree, &pool); }
 
   // Allocator
   allocator_type get_allocator() const { return this->_alloc; }
@@ -174,10 +400,32 @@ class map {
 
   // the map destructor
   ~map() {}
+
+ private:
+  static mapped_type& mappedOf(typename RBT::base_ptr x) { return (*iterator(x)).second; }
+
+  // the summaries above the node follow its new mapped value (a no-op without augmentation)
+#if FT_CXX11
+  template <class M>
+  void assignMapped(typename RBT::base_ptr x, M&& obj) {
+    mappedOf(x) = std::forward<M>(obj);
+    tree.pullPath(x);
+  }
+#else
+  template <class M>
+  void assignMapped(typename RBT::base_ptr x, const M& obj) {
+    mappedOf(x) = obj;
+    tree.pullPath(x);
+  }
+#endif
 };
 
-template <class Key, class T, class Compare, class Alloc>
-class map<Key, T, Compare, Alloc>::value_compare : public std::binary_function<value_type, value_type, bool> {  // in C++98, it is required to inherit binary_function<value_type,value_type,bool>
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+class map<Key, T, Compare, Alloc, NodePolicy>::value_compare
+#if __cplusplus < 201103L
+    : public std::binary_function<value_type, value_type, bool>  // in C++98, it is required to inherit binary_function<value_type,value_type,bool>
+#endif
+{
   friend class map;
 
  public:
@@ -191,31 +439,36 @@ class map<Key, T, Compare, Alloc>::value_compare : public std::binary_function<v
 };
 
 // relational operators for map
-template <class Key, class T, class Compare, class Alloc>
-bool operator==(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator==(const map<Key, T, Compare, Alloc, NodePolicy>& lhs, const map<Key, T, Compare, Alloc, NodePolicy>& rhs) {
   return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator!=(const map<Key, T, Compare, Alloc, NodePolicy>& lhs, const map<Key, T, Compare, Alloc, NodePolicy>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator<(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator<(const map<Key, T, Compare, Alloc, NodePolicy>& lhs, const map<Key, T, Compare, Alloc, NodePolicy>& rhs) {
   return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator<=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator<=(const map<Key, T, Compare, Alloc, NodePolicy>& lhs, const map<Key, T, Compare, Alloc, NodePolicy>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class Key, class T, class Compare, class Alloc>
-bool operator>(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator>(const map<Key, T, Compare, Alloc, NodePolicy>& lhs, const map<Key, T, Compare, Alloc, NodePolicy>& rhs) {
   return rhs < lhs;
 }
 
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+void swap(map<Key, T, Compare, Alloc, NodePolicy>& x, map<Key, T, Compare, Alloc, NodePolicy>& y) {
+  x.swap(y);
+}
+
 }  // namespace ft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,806 @@
+#include <cstring>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "benchmarks.hpp"
+
+// std::allocator opting out of the node pool, every node is a separate allocation (the tree before the pool)
+template <class T>
+class plain_allocator : public std::allocator<T> {
+ public:
+  template <class U>
+  struct rebind {
+    typedef plain_allocator<U> other;
+  };
+
+  plain_allocator() {}
+  template <class U>
+  plain_allocator(const plain_allocator<U> &copy) : std::allocator<T>(copy) {}
+};
+
+namespace ft {
+template <class T>
+struct use_node_pool<plain_allocator<T> > : public false_type {};
+}  // namespace ft
+
+template <class Map>
+static void bench_move_insert(const std::string &label, const std::string &str) {
+  const size_t count = bench_count / 10;
+
+  bench_timer timer;
+  {
+    Map mymap;
+    for (size_t i = 0; i < count; i++) mymap.insert(typename Map::value_type(rand(), std::string(str)));
+    Map moved(mymap);  // copy, then a move (or a second copy in c++98)
+    Map other(FT_MOVE(moved));
+    do_not_optimize(other);
+  }
+  report(label, count, timer.elapsed());
+}
+
+static void test_move_semantics(void) {
+  std::string str("a string long enough to live on the heap");
+
+  std::cout << "built with " << (FT_CXX11 ? "c++11 (move)" : "c++98 (copy)") << '\n';
+  srand(42);
+  bench_move_insert<ft::map<int, std::string> >("ft::map<int, std::string> insert + copy + move", str);
+  srand(42);
+  bench_move_insert<std::map<int, std::string> >("std::map<int, std::string> insert + copy + move", str);
+}
+
+// insert `count` random keys, erase half of them, then clear, a few rounds on the same map
+// so the later rounds run on recycled nodes (or on released & reallocated chunks)
+template <class Map>
+static void bench_node_allocator(const std::string &name) {
+  const size_t count = bench_count;
+  const int    rounds = 3;
+  double       insert_ms = 0, erase_ms = 0, clear_ms = 0;
+  bench_timer  timer;
+  Map          mymap;
+
+  srand(42);
+  for (int r = 0; r < rounds; r++) {
+    timer.reset();
+    for (size_t i = 0; i < count; i++) mymap.insert(typename Map::value_type(rand(), i));
+    insert_ms += timer.elapsed();
+
+    timer.reset();
+    for (size_t i = 0; i < count / 2; i++) mymap.erase(rand());
+    erase_ms += timer.elapsed();
+
+    timer.reset();
+    mymap.clear();
+    clear_ms += timer.elapsed();
+  }
+  report(name + " insert", count * rounds, insert_ms);
+  report(name + " erase", count / 2 * rounds, erase_ms);
+  report(name + " clear", count * rounds, clear_ms);
+}
+
+// less<int> counting its calls
+struct counting_less {
+  static size_t calls;
+
+  bool operator()(int lhs, int rhs) const {
+    calls++;
+    return lhs < rhs;
+  }
+};
+
+size_t counting_less::calls = 0;
+
+template <class Map>
+static void bench_unique_insert(const std::string &name) {
+  const size_t count = bench_count;
+  Map          mymap;
+
+  srand(42);
+  counting_less::calls = 0;
+  bench_timer timer;
+  for (size_t i = 0; i < count; i++) mymap[rand() % count] = i;  // about a third of the keys already exist
+  report(name + " operator[]", count, timer.elapsed());
+  std::cout << name << " comparisons per insert: " << (double)counting_less::calls / count << '\n';
+}
+
+static void test_unique_insert(void) {
+  bench_unique_insert<ft::map<int, size_t, counting_less> >("ft::map");
+  bench_unique_insert<std::map<int, size_t, counting_less> >("std::map");
+}
+
+// load sorted keys with & without a hint
+template <class Map>
+static void bench_sorted_load(const std::string &name) {
+  const size_t                         count = bench_count;
+  std::vector<typename Map::value_type> values;
+
+  for (size_t i = 0; i < count; i++) values.push_back(typename Map::value_type(i, i));
+
+  counting_less::calls = 0;
+  bench_timer timer;
+  {
+    Map mymap;
+    for (size_t i = 0; i < count; i++) mymap.insert(values[i]);
+    do_not_optimize(mymap);
+  }
+  report(name + " insert(val)", count, timer.elapsed());
+  std::cout << name << " comparisons per insert: " << (double)counting_less::calls / count << '\n';
+
+  counting_less::calls = 0;
+  timer.reset();
+  {
+    Map mymap;
+    mymap.insert(values.begin(), values.end());
+    do_not_optimize(mymap);
+  }
+  report(name + " insert(first, last)", count, timer.elapsed());
+  std::cout << name << " comparisons per insert: " << (double)counting_less::calls / count << '\n';
+}
+
+static void test_sorted_load(void) {
+  bench_sorted_load<ft::map<int, size_t, counting_less> >("ft::map");
+  bench_sorted_load<std::map<int, size_t, counting_less> >("std::map");
+}
+
+// build a map from a sorted vector, with the range constructor & with a loop of insert
+static void bench_bulk_build(size_t count) {
+  ft::vector<ft::pair<int, int> > values;
+  for (size_t i = 0; i < count; i++) values.push_back(ft::make_pair((int)i, (int)i));
+
+  std::string size = count >= 10000000 ? " 10M" : count >= 1000000 ? " 1M" : "";
+  bench_timer timer;
+  {
+    ft::map<int, int> mymap;
+    for (size_t i = 0; i < count; i++) mymap.insert(values[i]);
+    do_not_optimize(mymap);
+  }
+  report("ft::map insert loop" + size, count, timer.elapsed());
+
+  timer.reset();
+  {
+    ft::map<int, int> mymap(values.begin(), values.end());
+    do_not_optimize(mymap);
+  }
+  report("ft::map range constructor" + size, count, timer.elapsed());
+}
+
+static void test_bulk_build(void) {
+  bench_bulk_build(bench_count);
+  bench_bulk_build(bench_count * 10);
+}
+
+// copy construct & copy assign over a map of the same size
+template <class Map>
+static void bench_copy(const std::string &name) {
+  const size_t count = bench_count;
+  const int    rounds = 5;
+  Map          mymap, other;
+
+  srand(42);
+  for (size_t i = 0; i < count; i++) {
+    mymap[rand()] = i;
+    other[rand()] = i;
+  }
+
+  counting_less::calls = 0;
+  bench_timer timer;
+  for (int r = 0; r < rounds; r++) {
+    Map copy(mymap);
+    do_not_optimize(copy);
+  }
+  report(name + " copy constructor", mymap.size() * rounds, timer.elapsed());
+
+  timer.reset();
+  for (int r = 0; r < rounds; r++) {
+    other = mymap;  // every node of `other` is reused
+    do_not_optimize(other);
+  }
+  report(name + " copy assignment", mymap.size() * rounds, timer.elapsed());
+  std::cout << name << " comparisons: " << counting_less::calls << '\n';
+}
+
+static void test_copy(void) {
+  bench_copy<ft::map<int, size_t, counting_less> >("ft::map");
+  bench_copy<std::map<int, size_t, counting_less> >("std::map");
+}
+
+// a mapped value expensive to default construct (it allocates)
+struct heavy_value {
+  std::string text;
+
+  heavy_value() : text(256, ' ') {}
+};
+
+// std::string keys compared with const char * as they are (strcmp stops at the first difference, no strlen)
+struct transparent_less {
+  typedef void is_transparent;
+
+  bool operator()(const std::string &lhs, const std::string &rhs) const { return lhs < rhs; }
+  bool operator()(const std::string &lhs, const char *rhs) const { return std::strcmp(lhs.c_str(), rhs) < 0; }
+  bool operator()(const char *lhs, const std::string &rhs) const { return std::strcmp(lhs, rhs.c_str()) < 0; }
+};
+
+template <class Map>
+static void bench_heavy_find(const std::string &name) {
+  const size_t count = bench_count / 10;
+  Map          mymap;
+
+  for (size_t i = 0; i < count; i++) mymap[i * 2];
+  bench_timer timer;
+  size_t      found = 0;
+  for (size_t r = 0; r < 10; r++)
+    for (size_t i = 0; i < count; i++) found += mymap.find(i) != mymap.end();
+  do_not_optimize(found);
+  report(name, count * 10, timer.elapsed());
+}
+
+template <class Map>
+static void bench_string_find(const std::string &name) {
+  const size_t             count = bench_count / 10;
+  Map                      mymap;
+  std::vector<std::string> keys;
+
+  for (size_t i = 0; i < count; i++) {
+    keys.push_back("a key long enough to be allocated #" + std::string(1, 'a' + i % 26) + std::string(i % 7, 'z'));
+    keys.back() += std::string(1, 'a' + i / 26 % 26) + std::string(1, 'a' + i / 676 % 26) + std::string(1, 'a' + i / 17576 % 26);
+    mymap[keys.back()] = i;
+  }
+  bench_timer timer;
+  size_t      found = 0;
+  for (size_t r = 0; r < 10; r++)
+    for (size_t i = 0; i < count; i++) found += mymap.find(keys[i].c_str()) != mymap.end();
+  do_not_optimize(found);
+  report(name, count * 10, timer.elapsed());
+}
+
+static void test_key_lookup(void) {
+  bench_heavy_find<ft::map<size_t, heavy_value> >("ft::map<size_t, heavy_value> find");
+  bench_heavy_find<std::map<size_t, heavy_value> >("std::map<size_t, heavy_value> find");
+  bench_string_find<ft::map<std::string, size_t, transparent_less> >("ft::map<std::string> transparent find(char *)");
+  bench_string_find<ft::map<std::string, size_t> >("ft::map<std::string> find(char *)");
+  bench_string_find<std::map<std::string, size_t> >("std::map<std::string> find(char *)");
+}
+
+// erase half of the map : every other key by iterator, by key, then the first half with one range erase
+template <class Map>
+static void bench_erase_half(const std::string &name) {
+  const size_t count = bench_count;
+  Map          model;
+
+  for (size_t i = 0; i < count; i++) model[i] = i;
+
+  Map         mymap(model);
+  bench_timer timer;
+  for (typename Map::iterator it = mymap.begin(); it != mymap.end();) {
+    typename Map::iterator next = it;
+    ++next;
+    if (it->first % 2) mymap.erase(it);
+    it = next;
+  }
+  report(name + " erase(iterator)", count / 2, timer.elapsed());
+
+  mymap = model;
+  timer.reset();
+  for (size_t i = 1; i < count; i += 2) mymap.erase(i);
+  report(name + " erase(key)", count / 2, timer.elapsed());
+
+  mymap = model;
+  timer.reset();
+  mymap.erase(mymap.begin(), mymap.find(count / 2));
+  report(name + " erase(first, last)", count / 2, timer.elapsed());
+}
+
+static void test_erase_half(void) {
+  bench_erase_half<ft::map<int, size_t> >("ft::map");
+  bench_erase_half<std::map<int, size_t> >("std::map");
+}
+
+// begin() or rbegin() followed by a short scan, over & over
+template <class Map>
+static void bench_begin_scan(const std::string &name) {
+  const size_t count = bench_count;
+  Map          mymap;
+
+  for (size_t i = 0; i < count; i++) mymap[i] = i;
+
+  bench_timer timer;
+  size_t      sum = 0;
+  for (size_t r = 0; r < count; r++) {
+    typename Map::iterator it = mymap.begin();
+    for (int i = 0; i < 4; i++, it++) sum += it->second;
+  }
+  report(name + " begin() + 4 steps", count, timer.elapsed());
+
+  timer.reset();
+  for (size_t r = 0; r < count; r++) {
+    typename Map::reverse_iterator it = mymap.rbegin();
+    for (int i = 0; i < 4; i++, it++) sum += it->second;
+  }
+  report(name + " rbegin() + 4 steps", count, timer.elapsed());
+  do_not_optimize(sum);
+}
+
+static void test_begin_scan(void) {
+  bench_begin_scan<ft::map<int, size_t> >("ft::map");
+  bench_begin_scan<std::map<int, size_t> >("std::map");
+}
+
+// short lived maps, created & destroyed over & over : an empty ft::map owns no node (its end node is a member
+// of the tree), so it allocates nothing, a tiny one allocates the first chunk of its pool
+template <class Map>
+static void bench_small_maps(const std::string &name, int size) {
+  const size_t rounds = bench_count;
+
+  alloc_stats::reset();
+  bench_timer timer;
+  for (size_t r = 0; r < rounds; r++) {
+    Map mymap;
+    for (int i = 0; i < size; i++) mymap.insert(typename Map::value_type(i, r));
+    do_not_optimize(mymap);
+  }
+  double ms = timer.elapsed();
+  report(name + " create & destroy, " + std::string(1, '0' + size) + " elements", rounds, ms);
+  std::cout << "    allocations per map: " << (double)alloc_stats::allocations / rounds << '\n';
+}
+
+static void test_small_maps(void) {
+  typedef counting_allocator<ft::pair<const int, size_t> >  ft_alloc;
+  typedef counting_allocator<std::pair<const int, size_t> > std_alloc;
+
+  for (int size = 0; size <= 4; size += 2) {
+    bench_small_maps<ft::map<int, size_t, std::less<int>, ft_alloc> >("ft::map", size);
+    bench_small_maps<std::map<int, size_t, std::less<int>, std_alloc> >("std::map", size);
+  }
+}
+
+// memory of the map (peak of the allocator, pool chunks included) scaled to a million keys,
+// then random lookups : the node layout only changes how many nodes fit in the caches
+template <class Map>
+static void bench_node_layout(const std::string &name) {
+  const size_t count = bench_count;
+  const size_t lookups = bench_count;
+
+  alloc_stats::reset();
+  Map mymap;
+  srand(42);
+  for (size_t i = 0; i < count; i++) mymap.insert(typename Map::value_type(rand(), i));
+  std::cout << "    " << name << ": " << (double)alloc_stats::peak_bytes / mymap.size() << " bytes per key, "
+            << (double)alloc_stats::peak_bytes / mymap.size() * 1000000 / (1024 * 1024) << " MiB per 1M keys\n";
+
+  bench_timer timer;
+  size_t      found = 0;
+  srand(43);
+  for (size_t i = 0; i < lookups; i++) found += mymap.count(rand());
+  report(name + " find", lookups, timer.elapsed());
+  do_not_optimize(found);
+}
+
+static void test_node_layout(void) {
+  typedef counting_allocator<ft::pair<const int, int> >  ft_alloc;
+  typedef counting_allocator<std::pair<const int, int> > std_alloc;
+
+  bench_node_layout<ft::map<int, int, std::less<int>, ft_alloc, ft::compact_node> >("ft::map compact_node");
+  bench_node_layout<ft::map<int, int, std::less<int>, ft_alloc, ft::plain_node> >("ft::map plain_node");
+  bench_node_layout<std::map<int, int, std::less<int>, std_alloc> >("std::map");
+}
+
+// clear() & destructor of big maps : a pooled tree drops its nodes with the chunks of its pool (without visiting
+// them when the values have no destructor), the other trees walk their nodes to destroy & deallocate them
+template <class Map>
+static void bench_teardown(const std::string &name, size_t count) {
+  Map *mymap = new Map;
+
+  for (size_t i = 0; i < count; i++) mymap->insert(mymap->end(), typename Map::value_type(i, typename Map::mapped_type()));
+  bench_timer timer;
+  mymap->clear();
+  report(name + " clear()", count, timer.elapsed());
+
+  for (size_t i = 0; i < count; i++) mymap->insert(mymap->end(), typename Map::value_type(i, typename Map::mapped_type()));
+  timer.reset();
+  delete mymap;
+  report(name + " destructor", count, timer.elapsed());
+}
+
+static void test_teardown(void) {
+  const size_t count = bench_count * 10;
+
+  bench_teardown<ft::map<int, size_t> >("ft::map<int, size_t> pool", count);
+  bench_teardown<ft::map<int, size_t, std::less<int>, plain_allocator<ft::pair<const int, size_t> > > >("ft::map<int, size_t> plain", count);
+  bench_teardown<std::map<int, size_t> >("std::map<int, size_t>", count);
+  bench_teardown<ft::map<int, std::string> >("ft::map<int, string> pool", count);
+  bench_teardown<ft::map<int, std::string, std::less<int>, plain_allocator<ft::pair<const int, std::string> > > >("ft::map<int, string> plain", count);
+  bench_teardown<std::map<int, std::string> >("std::map<int, string>", count);
+}
+
+// order statistics : O(log n) on a counted map, by walking the elements on the others
+template <class Map>
+static typename Map::iterator walk_nth(Map &mymap, size_t k) {
+  typename Map::iterator it = mymap.begin();
+  while (k--) ++it;
+  return it;
+}
+
+template <class Iterator>
+static long walk_distance(Iterator first, Iterator last) {
+  long n = 0;
+  for (; first != last; ++first) n++;
+  return n;
+}
+
+template <class Map>
+static typename Map::iterator order_nth(Map &mymap, size_t k) {
+  return walk_nth(mymap, k);
+}
+template <class Map>
+static size_t order_rank(Map &mymap, int k) {
+  return walk_distance(mymap.begin(), mymap.lower_bound(k));
+}
+template <class Map>
+static long order_distance(Map &, typename Map::iterator first, typename Map::iterator last) {
+  return walk_distance(first, last);
+}
+
+template <class K, class V, class C, class A>
+static typename ft::map<K, V, C, A, ft::counted_node<> >::iterator order_nth(ft::map<K, V, C, A, ft::counted_node<> > &mymap, size_t k) {
+  return mymap.nth(k);
+}
+template <class K, class V, class C, class A>
+static size_t order_rank(ft::map<K, V, C, A, ft::counted_node<> > &mymap, int k) {
+  return mymap.rank(k);
+}
+template <class K, class V, class C, class A>
+static long order_distance(ft::map<K, V, C, A, ft::counted_node<> > &mymap, typename ft::map<K, V, C, A, ft::counted_node<> >::iterator first,
+                           typename ft::map<K, V, C, A, ft::counted_node<> >::iterator last) {
+  return mymap.distance(first, last);
+}
+
+// keeping the subtree sizes up to date costs a little on every insertion & erasure
+template <class Map>
+static void bench_counted_updates(const std::string &name) {
+  const size_t count = bench_count;
+  Map          mymap;
+
+  srand(42);
+  bench_timer timer;
+  for (size_t i = 0; i < count; i++) mymap.insert(typename Map::value_type(rand(), i));
+  report(name + " insert", count, timer.elapsed());
+  timer.reset();
+  for (size_t i = 0; i < count; i++) mymap.erase(rand());
+  report(name + " erase", count, timer.elapsed());
+}
+
+// nth, rank & distance on a counted map, against walking the elements of a std::map
+template <class Map>
+static void bench_order_queries(const std::string &name) {
+  const size_t count = bench_count / 10;
+  const size_t queries = 1000;
+  Map          mymap;
+  size_t       sum = 0;
+
+  for (size_t i = 0; i < count; i++) mymap[i * 2] = i;
+  srand(42);
+  bench_timer timer;
+  for (size_t q = 0; q < queries; q++) sum += order_nth(mymap, rand() % count)->second;
+  report(name + " nth", queries, timer.elapsed());
+  timer.reset();
+  for (size_t q = 0; q < queries; q++) sum += order_rank(mymap, rand() % (count * 2));
+  report(name + " rank", queries, timer.elapsed());
+  timer.reset();
+  for (size_t q = 0; q < queries; q++) sum += order_distance(mymap, mymap.lower_bound(rand() % count), mymap.lower_bound(count + rand() % count));
+  report(name + " distance", queries, timer.elapsed());
+  do_not_optimize(sum);
+}
+
+static void test_order_statistics(void) {
+  typedef ft::map<int, size_t, std::less<int>, std::allocator<ft::pair<const int, size_t> >, ft::counted_node<> > counted_map;
+
+  bench_counted_updates<ft::map<int, size_t> >("ft::map compact_node");
+  bench_counted_updates<counted_map>("ft::map counted_node");
+  bench_counted_updates<std::map<int, size_t> >("std::map");
+  bench_order_queries<counted_map>("ft::map counted_node");
+  bench_order_queries<ft::map<int, size_t> >("ft::map walk");
+  bench_order_queries<std::map<int, size_t> >("std::map walk");
+}
+
+// range aggregates : O(log n) on an augmented map, by walking the range on the others
+struct long_sum {
+  typedef long value_type;
+
+  static long identity(void) { return 0; }
+  static long combine(long lhs, long rhs) { return lhs + rhs; }
+  static long of(const ft::pair<const int, long> &v) { return v.second; }
+};
+
+template <class Map>
+static long range_sum(const Map &mymap, int lo, int hi) {
+  long sum = 0;
+  for (typename Map::const_iterator it = mymap.lower_bound(lo); it != mymap.end() && it->first < hi; ++it) sum += it->second;
+  return sum;
+}
+template <class K, class V, class C, class A>
+static long range_sum(const ft::map<K, V, C, A, ft::augmented_node<long_sum> > &mymap, int lo, int hi) {
+  return mymap.aggregate(lo, hi);
+}
+
+template <class Map>
+static void bench_range_sums(const std::string &name) {
+  const size_t count = bench_count / 10;
+  const size_t queries = 1000;
+  const size_t widths[] = {10, 1000, 100000};
+  Map          mymap;
+  long         sum = 0;
+
+  for (size_t i = 0; i < count; i++) mymap.insert(typename Map::value_type(i, long(i)));
+  for (size_t w = 0; w < sizeof(widths) / sizeof(*widths); w++) {
+    srand(42);
+    bench_timer timer;
+    for (size_t q = 0; q < queries; q++) {
+      int lo = rand() % count;
+      sum += range_sum(mymap, lo, lo + widths[w]);
+    }
+    std::ostringstream label;
+    label << name << " width " << widths[w];
+    report(label.str(), queries, timer.elapsed());
+  }
+  do_not_optimize(sum);
+}
+
+static void test_range_aggregate(void) {
+  typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >, ft::augmented_node<long_sum> > summed_map;
+
+  bench_counted_updates<summed_map>("ft::map augmented_node");
+  bench_range_sums<summed_map>("ft::map aggregate");
+  bench_range_sums<ft::map<int, long> >("ft::map walk");
+  bench_range_sums<std::map<int, long> >("std::map walk");
+}
+
+// multimaps & multisets with few keys & long runs of equal keys : every key is counted, walked & erased
+template <class Multi>
+static typename Multi::value_type dup_value(const Multi &, int k, size_t i) {
+  return typename Multi::value_type(k, i);
+}
+static int dup_value(const std::multiset<int> &, int k, size_t) { return k; }
+static int dup_value(const ft::multiset<int> &, int k, size_t) { return k; }
+
+template <class Multi>
+static void bench_duplicates(const std::string &name, int keys) {
+  const size_t count = bench_count;
+  Multi        multi;
+  size_t       sum = 0;
+
+  srand(42);
+  bench_timer timer;
+  for (size_t i = 0; i < count; i++) multi.insert(dup_value(multi, rand() % keys, i));
+  report(name + " insert", count, timer.elapsed());
+  timer.reset();
+  for (size_t q = 0; q < count; q++) sum += multi.equal_range(rand() % keys).first != multi.end();
+  report(name + " equal_range", count, timer.elapsed());
+  timer.reset();
+  for (int k = 0; k < keys; k++) sum += multi.count(k);
+  report(name + " count", count, timer.elapsed());
+  timer.reset();
+  for (int k = 0; k < keys; k++) sum += multi.erase(k);
+  report(name + " erase", count, timer.elapsed());
+  do_not_optimize(sum);
+}
+
+static void test_duplicates(void) {
+  const int keys[] = {10, 1000};
+
+  for (size_t i = 0; i < sizeof(keys) / sizeof(*keys); i++) {
+    std::ostringstream suffix;
+    suffix << " " << keys[i] << " keys";
+    bench_duplicates<ft::multimap<int, size_t> >("ft::multimap" + suffix.str(), keys[i]);
+    bench_duplicates<std::multimap<int, size_t> >("std::multimap" + suffix.str(), keys[i]);
+    bench_duplicates<ft::multiset<int> >("ft::multiset" + suffix.str(), keys[i]);
+    bench_duplicates<std::multiset<int> >("std::multiset" + suffix.str(), keys[i]);
+  }
+}
+
+// set algebra on a large set & a smaller one (half of its keys in the large one) : split & join on ft::set,
+// against the element loops (insert, find, erase) on both sets. the operands are rebuilt out of the timings
+template <class Set>
+static void algebra_operands(Set &large, Set &small, size_t n, size_t m) {
+  srand(42);
+  for (size_t i = 0; i < n; i++) large.insert(long(i) * 2);
+  for (size_t i = 0; i < m; i++) small.insert(long(rand() % (n * 2)));
+}
+
+template <class Set>
+static void loop_union(Set &large, Set &small) {
+  large.insert(small.begin(), small.end());
+}
+template <class Set>
+static void loop_intersection(Set &large, Set &small) {
+  Set result;
+  for (typename Set::iterator it = small.begin(); it != small.end(); ++it)
+    if (large.find(*it) != large.end()) result.insert(result.end(), *it);
+  large.swap(result);
+}
+template <class Set>
+static void loop_difference(Set &large, Set &small) {
+  for (typename Set::iterator it = small.begin(); it != small.end(); ++it) large.erase(*it);
+}
+
+template <class Set>
+static void join_union(Set &large, Set &small) {
+  large.set_union(small);
+}
+template <class Set>
+static void join_intersection(Set &large, Set &small) {
+  large.set_intersection(small);
+}
+template <class Set>
+static void join_difference(Set &large, Set &small) {
+  large.set_difference(small);
+}
+
+template <class Set>
+static void bench_algebra_op(const std::string &label, void (*op)(Set &, Set &), size_t n, size_t m) {
+  Set large, small;
+
+  algebra_operands(large, small, n, m);
+  bench_timer timer;
+  op(large, small);
+  report(label, m, timer.elapsed());
+  do_not_optimize(large.size());
+}
+
+static void test_set_algebra(void) {
+  const size_t n = bench_count;
+  const size_t sizes[] = {n / 1000, n / 10, n};
+
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++) {
+    std::ostringstream suffix;
+    suffix << " " << n << " & " << sizes[i];
+    bench_algebra_op<ft::set<long> >("ft::set join union" + suffix.str(), join_union, n, sizes[i]);
+    bench_algebra_op<ft::set<long> >("ft::set loop union" + suffix.str(), loop_union, n, sizes[i]);
+    bench_algebra_op<std::set<long> >("std::set loop union" + suffix.str(), loop_union, n, sizes[i]);
+    bench_algebra_op<ft::set<long> >("ft::set join intersection" + suffix.str(), join_intersection, n, sizes[i]);
+    bench_algebra_op<ft::set<long> >("ft::set loop intersection" + suffix.str(), loop_intersection, n, sizes[i]);
+    bench_algebra_op<std::set<long> >("std::set loop intersection" + suffix.str(), loop_intersection, n, sizes[i]);
+    bench_algebra_op<ft::set<long> >("ft::set join difference" + suffix.str(), join_difference, n, sizes[i]);
+    bench_algebra_op<ft::set<long> >("ft::set loop difference" + suffix.str(), loop_difference, n, sizes[i]);
+    bench_algebra_op<std::set<long> >("std::set loop difference" + suffix.str(), loop_difference, n, sizes[i]);
+  }
+}
+
+// the parallel set algebra & bulk build on 1 to N threads (N the number of processors, 4 at least) : both operands
+// have n elements, half of them common. the grain is the default one of the pool
+template <class Op>
+static void bench_parallel_op(const std::string &label, Op op, size_t n, ft::thread_pool *pool) {
+  ft::set<long> large, other;
+
+  algebra_operands(large, other, n, 0);
+  for (size_t i = 0; i < n; i++) other.insert(long(i) * 2 + (i & 1));
+  bench_timer timer;
+  op(large, other, pool);
+  report(label, n, timer.elapsed());
+  do_not_optimize(large.size());
+}
+
+struct parallel_union {
+  void operator()(ft::set<long> &a, ft::set<long> &b, ft::thread_pool *pool) const { pool ? a.set_union(b, *pool) : a.set_union(b); }
+};
+struct parallel_intersection {
+  void operator()(ft::set<long> &a, ft::set<long> &b, ft::thread_pool *pool) const { pool ? a.set_intersection(b, *pool) : a.set_intersection(b); }
+};
+struct parallel_difference {
+  void operator()(ft::set<long> &a, ft::set<long> &b, ft::thread_pool *pool) const { pool ? a.set_difference(b, *pool) : a.set_difference(b); }
+};
+
+static void bench_parallel_build(const std::string &label, const std::vector<long> &sorted, ft::thread_pool *pool) {
+  ft::set<long> s;
+  bench_timer   timer;
+
+  if (pool)
+    s.insert(sorted.begin(), sorted.end(), *pool);
+  else
+    s.insert(sorted.begin(), sorted.end());
+  report(label, sorted.size(), timer.elapsed());
+  do_not_optimize(s.size());
+}
+
+static void test_parallel_scaling(void) {
+  const size_t      n = bench_count;
+  const size_t      max_threads = ft::thread_pool::processors() < 4 ? 4 : ft::thread_pool::processors();
+  std::vector<long> sorted;
+
+  for (size_t i = 0; i < n; i++) sorted.push_back(long(i) * 3);
+  bench_parallel_build("ft::set build sequential", sorted, 0);
+  bench_parallel_op("ft::set union sequential", parallel_union(), n, 0);
+  bench_parallel_op("ft::set intersection sequential", parallel_intersection(), n, 0);
+  bench_parallel_op("ft::set difference sequential", parallel_difference(), n, 0);
+  for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+    ft::thread_pool    pool(threads);
+    std::ostringstream suffix;
+
+    suffix << " " << threads << " thread" << (threads > 1 ? "s" : "");
+    bench_parallel_build("ft::set build" + suffix.str(), sorted, &pool);
+    bench_parallel_op("ft::set union" + suffix.str(), parallel_union(), n, &pool);
+    bench_parallel_op("ft::set intersection" + suffix.str(), parallel_intersection(), n, &pool);
+    bench_parallel_op("ft::set difference" + suffix.str(), parallel_difference(), n, &pool);
+  }
+}
+
+// a record of the index, the nodes of the map take a cache line
+struct record {
+  long id;
+  long fields[3];
+};
+
+typedef ft::map<long, record> record_map;
+
+// 8x the base count of random keys (a tree larger than the last level cache with the default count),
+// looked up by requests of `batch` keys : a loop of find, then find_many
+static void bench_batch_lookup(size_t batch) {
+  const size_t      n = bench_count * 8;
+  const size_t      lookups = bench_count;
+  std::vector<long> keys;
+  record_map        index;
+  record            r = {0, {0, 0, 0}};
+
+  srand(42);
+  for (size_t i = 0; i < n; i++) {
+    r.id = long(rand()) * RAND_MAX + rand();
+    index.insert(record_map::value_type(r.id, r));
+    if (i % (n / lookups) == 0) keys.push_back(i % 2 ? r.id : r.id + 1);  // half of them are missing
+  }
+  for (size_t i = keys.size() - 1; i > 0; i--) std::swap(keys[i], keys[rand() % (i + 1)]);
+
+  std::vector<record_map::const_iterator> found(batch);
+  std::ostringstream                      label;
+  size_t                                  hits = 0;
+  bench_timer                             timer;
+
+  std::cout << index.size() << " keys, " << sizeof(record_map::value_type) << " bytes per value\n";
+  label << "ft::map<long, record> requests of " << batch;
+  for (size_t i = 0; i + batch <= keys.size(); i += batch)
+    for (size_t j = 0; j < batch; j++) {
+      found[j] = index.find(keys[i + j]);
+      hits += found[j] != index.end();
+    }
+  report(label.str() + " find", keys.size() / batch * batch, timer.elapsed());
+  do_not_optimize(hits);
+
+  timer.reset();
+  for (size_t i = 0; i + batch <= keys.size(); i += batch) {
+    index.find_many(keys.begin() + i, keys.begin() + i + batch, found.begin());
+    for (size_t j = 0; j < batch; j++) hits -= found[j] != index.end();
+  }
+  report(label.str() + " find_many", keys.size() / batch * batch, timer.elapsed());
+  std::cout << "same results: " << (hits == 0 ? "yes" : "no") << '\n';
+}
+
+static void test_batch_lookup(void) {
+  bench_batch_lookup(16);
+  bench_batch_lookup(256);
+}
+
+static void test_node_allocator(void) {
+  bench_node_allocator<ft::map<int, size_t> >("ft::map pool");
+  bench_node_allocator<ft::map<int, size_t, std::less<int>, plain_allocator<ft::pair<const int, size_t> > > >("ft::map plain");
+  bench_node_allocator<std::map<int, size_t> >("std::map");
+}
+
+void map_bench(void) {
+  start_bench("Bench move semantics", test_move_semantics);
+  start_bench("Bench node allocator", test_node_allocator);
+  start_bench("Bench unique insert", test_unique_insert);
+  start_bench("Bench sorted load", test_sorted_load);
+  start_bench("Bench bulk build", test_bulk_build);
+  start_bench("Bench copy", test_copy);
+  start_bench("Bench key lookup", test_key_lookup);
+  start_bench("Bench batch lookup", test_batch_lookup);
+  start_bench("Bench erase half", test_erase_half);
+  start_bench("Bench begin scan", test_begin_scan);
+  start_bench("Bench small maps", test_small_maps);
+  start_bench("Bench node layout", test_node_layout);
+  start_bench("Bench teardown", test_teardown);
+  start_bench("Bench order statistics", test_order_statistics);
+  start_bench("Bench range aggregate", test_range_aggregate);
+  start_bench("Bench duplicates", test_duplicates);
+  start_bench("Bench set algebra", test_set_algebra);
+  start_bench("Bench parallel scaling", test_parallel_scaling);
+}
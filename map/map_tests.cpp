@@ -6,6 +6,77 @@ struct classcomp {
   bool operator()(const char& lhs, const char& rhs) const { return lhs < rhs; }
 };
 
+// compares std::string keys with const char * without building a std::string
+struct transparent_less {
+  typedef void is_transparent;
+
+  bool operator()(const std::string& lhs, const std::string& rhs) const { return lhs < rhs; }
+  bool operator()(const std::string& lhs, const char* rhs) const { return lhs.compare(rhs) < 0; }
+  bool operator()(const char* lhs, const std::string& rhs) const { return rhs.compare(lhs) > 0; }
+};
+
+// total volume of the price levels of a range
+struct volume_sum {
+  typedef long value_type;
+
+  static long identity(void) { return 0; }
+  static long combine(long lhs, long rhs) { return lhs + rhs; }
+  static long of(const ft::pair<const int, long>& level) { return level.second; }
+};
+
+// std has no range aggregates, the std build walks the range
+#if STD
+typedef std::map<int, long> volume_map;
+
+static long volume_between(const volume_map& levels, int lo, int hi) {
+  long sum = 0;
+  for (volume_map::const_iterator it = levels.lower_bound(lo); it != levels.end() && it->first < hi; ++it) sum += it->second;
+  return sum;
+}
+static void volume_changed(volume_map&, volume_map::iterator) {}
+static void set_volume(volume_map& levels, int price, long volume) { levels[price] = volume; }
+#else
+typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >, ft::augmented_node<volume_sum> > volume_map;
+
+static long volume_between(const volume_map& levels, int lo, int hi) { return levels.aggregate(lo, hi); }
+static void volume_changed(volume_map& levels, volume_map::iterator it) { levels.refresh(it); }
+static void set_volume(volume_map& levels, int price, long volume) { levels.insert_or_assign(price, volume); }  // no refresh needed
+#endif
+
+// std has no set algebra on the maps themselves (nor merge before C++17), the std build does it element by element
+typedef ft::map<int, std::string> word_map;
+
+#if STD
+static void merge_of(word_map& dst, word_map& src) {
+  for (word_map::iterator it = src.begin(); it != src.end();) {
+    if (dst.insert(*it).second)
+      src.erase(it++);
+    else
+      ++it;
+  }
+}
+static void union_of(word_map& dst, word_map& src) {
+  dst.insert(src.begin(), src.end());
+  src.clear();
+}
+static void intersection_of(word_map& dst, const word_map& other) {
+  for (word_map::iterator it = dst.begin(); it != dst.end();) {
+    if (other.count(it->first))
+      ++it;
+    else
+      dst.erase(it++);
+  }
+}
+static void difference_of(word_map& dst, const word_map& other) {
+  for (word_map::const_iterator it = other.begin(); it != other.end(); ++it) dst.erase(it->first);
+}
+#else
+static void merge_of(word_map& dst, word_map& src) { dst.merge(src); }
+static void union_of(word_map& dst, word_map& src) { dst.set_union(src); }
+static void intersection_of(word_map& dst, const word_map& other) { dst.set_intersection(other); }
+static void difference_of(word_map& dst, const word_map& other) { dst.set_difference(other); }
+#endif
+
 static void test_constructor(void) {
   ft::map<char, int> first;
 
@@ -113,6 +184,83 @@ static void test_access_element(void) {
   std::cout << "mymap now contains " << mymap.size() << " elements.\n";
 }
 
+// a mapped value counting how it's built
+struct tracked {
+  static int built, copied, assigned;
+  std::string name;
+
+  tracked() : name("none") { built++; }
+  tracked(const std::string& s) : name(s) { built++; }
+  tracked(const tracked& other) : name(other.name) { copied++; }
+  tracked& operator=(const tracked& other) {
+    name = other.name;
+    assigned++;
+    return *this;
+  }
+};
+
+int tracked::built = 0, tracked::copied = 0, tracked::assigned = 0;
+
+typedef ft::map<int, tracked> tracked_map;
+
+// std has try_emplace & insert_or_assign since C++17 only, the std build searches first
+#if STD && __cplusplus < 201703L
+static bool try_put(tracked_map& m, int k, const std::string& name) {
+  if (m.count(k)) return false;
+  return m.insert(tracked_map::value_type(k, tracked(name))).second;
+}
+static bool put(tracked_map& m, int k, const tracked& value) {
+  tracked_map::iterator it = m.find(k);
+
+#if __cplusplus >= 201103L
+  if (it == m.end()) return m.emplace(k, value).second;
+#else
+  if (it == m.end()) return m.insert(tracked_map::value_type(k, value)).second;
+#endif
+  it->second = value;
+  return false;
+}
+#elif STD
+static bool try_put(tracked_map& m, int k, const std::string& name) { return m.try_emplace(k, name).second; }
+static bool put(tracked_map& m, int k, const tracked& value) { return m.insert_or_assign(k, value).second; }
+#else
+// the factory is only called for a new key
+struct tracked_named {
+  const std::string& name;
+  tracked_named(const std::string& s) : name(s) {}
+  tracked            operator()() const { return tracked(name); }
+};
+static bool try_put(tracked_map& m, int k, const std::string& name) { return m.try_emplace_with(k, tracked_named(name)).second; }
+static bool put(tracked_map& m, int k, const tracked& value) { return m.insert_or_assign(k, value).second; }
+#endif
+
+static void print_counts(const char* what) {
+  std::cout << what << "built " << tracked::built;
+#if __cplusplus >= 201103L  // the c++98 std::map copies the values into its nodes
+  std::cout << ", copied " << tracked::copied;
+#endif
+  std::cout << ", assigned " << tracked::assigned << '\n';
+}
+
+static void test_try_emplace(void) {
+  tracked_map m;
+
+  m[1].name = "one";
+  m[1].name += "!";
+  m[2];
+  print_counts("operator[]: ");
+
+  tracked::built = 0;
+  std::cout << "try_put: " << try_put(m, 3, "three") << ' ' << try_put(m, 1, "uno") << '\n';
+  std::cout << "built " << tracked::built << ", assigned " << tracked::assigned << '\n';
+
+  tracked two("two");
+  tracked::built = tracked::copied = 0;
+  std::cout << "put: " << put(m, 2, two) << ' ' << put(m, 4, two) << '\n';
+  print_counts("");
+  for (tracked_map::iterator it = m.begin(); it != m.end(); ++it) std::cout << it->first << " => " << it->second.name << '\n';
+}
+
 static void test_insert(void) {
   ft::map<char, int> mymap;
 
@@ -187,6 +335,46 @@ static void test_swap(void) {
   for (ft::map<char, int>::iterator it = bar.begin(); it != bar.end(); ++it) std::cout << it->first << " => " << it->second << '\n';
 }
 
+static void test_swap_iterators(void) {
+  ft::map<int, std::string> foo, bar;
+
+  for (int i = 0; i < 100; i++) foo[i] = "foo";
+  bar[-1] = "bar";
+
+  ft::map<int, std::string>::iterator first = foo.begin(), middle = foo.find(50), last = --foo.end(), single = bar.begin();
+  ft::swap(foo, bar);  // the non member swap
+
+  // the iterators now walk the other map
+  std::cout << first->first << " " << middle->first << " " << last->first << " " << single->first << '\n';
+  int count = 0;
+  for (ft::map<int, std::string>::iterator it = middle; it != bar.end(); it++) count++;
+  std::cout << "from middle to bar.end(): " << count << '\n';
+  std::cout << "foo: " << foo.size() << " " << (foo.begin() == single) << ", bar: " << bar.size() << " " << (bar.begin() == first) << '\n';
+
+  foo.swap(bar);
+  foo.erase(middle);
+  std::cout << "foo: " << foo.size() << " " << first->second << " " << (--foo.end() == last) << '\n';
+}
+
+static void test_empty_maps(void) {
+  ft::map<int, std::string> empty, one;
+
+  std::cout << (empty.begin() == empty.end()) << " " << (empty.rbegin() == empty.rend()) << " " << (empty.find(1) == empty.end()) << '\n';
+  one[1] = "one";
+  empty.swap(one);  // the elements go to the other map, each map keeps its own end
+  std::cout << empty.size() << " " << empty.begin()->second << " " << (--empty.end() == empty.begin()) << " " << (one.begin() == one.end()) << '\n';
+
+  ft::map<int, std::string> copy(one);
+  copy = one;
+  std::cout << copy.size() << " " << (copy.begin() == copy.end()) << '\n';
+
+  empty.erase(empty.begin());
+  std::cout << empty.size() << " " << (empty.begin() == empty.end()) << " " << (empty.rbegin() == empty.rend()) << '\n';
+  empty[2] = "two";
+  empty[0] = "zero";
+  for (ft::map<int, std::string>::reverse_iterator it = empty.rbegin(); it != empty.rend(); ++it) std::cout << it->first << " => " << it->second << '\n';
+}
+
 static void test_clear(void) {
   ft::map<char, int> mymap;
 
@@ -260,6 +448,35 @@ static void test_find(void) {
   std::cout << "d => " << mymap.find('d')->second << '\n';
 }
 
+// std has no batched lookup, the std build finds the keys one by one
+template <class Map>
+static typename Map::const_iterator* find_all(const Map& m, const int* first, const int* last, typename Map::const_iterator* out) {
+#if STD
+  for (; first != last; ++first, ++out) *out = m.find(*first);
+  return out;
+#else
+  return m.find_many(first, last, out);
+#endif
+}
+
+static void test_find_many(void) {
+  ft::map<int, int> squares;
+  const int         keys[] = {4, 99, 0, 16, 7, -3, 36, 36, 1, 50, 64, 8, 81, 2, 100, 9, 25, 3, 49, 121};
+  const size_t      n = sizeof(keys) / sizeof(keys[0]);
+
+  ft::map<int, int>::const_iterator found[n];
+  for (int i = 0; i <= 10; i++) squares[i * i] = i;
+  std::cout << "empty map: " << (find_all(ft::map<int, int>(), keys, keys + 3, found) - found) << '\n';
+  std::cout << "written: " << (find_all(squares, keys, keys + n, found) - found) << '\n';
+  for (size_t i = 0; i < n; i++) {
+    std::cout << keys[i] << ": ";
+    if (found[i] == squares.end())
+      std::cout << "missing\n";
+    else
+      std::cout << found[i]->second << '\n';
+  }
+}
+
 static void test_count(void) {
   ft::map<char, int> mymap;
   char               c;
@@ -328,6 +545,254 @@ static void test_get_allocator(void) {
   mymap.get_allocator().deallocate(p, 5);
 }
 
+static void test_insert_hint(void) {
+  ft::map<int, int>           mymap;
+  ft::map<int, int>::iterator it;
+
+  // right hints : sorted values hinted with end() & with the previous value
+  for (int i = 0; i < 100; i += 2) mymap.insert(mymap.end(), ft::make_pair(i, i));
+  it = mymap.begin();
+  for (int i = 1; i < 100; i += 4) it = mymap.insert(it, ft::make_pair(i, i));
+  // wrong hints & an existing key
+  mymap.insert(mymap.begin(), ft::make_pair(99, 99));
+  mymap.insert(mymap.find(50), ft::make_pair(7, 7));
+  it = mymap.insert(mymap.find(10), ft::make_pair(20, -1));
+  std::cout << "existing: " << it->first << " => " << it->second << '\n';
+
+  // descending range, each value goes right before the previous one
+  ft::map<int, int> other;
+  for (ft::map<int, int>::reverse_iterator rit = mymap.rbegin(); rit != mymap.rend(); rit++) other.insert(other.begin(), *rit);
+  other.insert(mymap.begin(), mymap.end());
+
+  std::cout << "size: " << mymap.size() << " " << other.size() << '\n';
+  for (it = other.begin(); it != other.end(); it++) std::cout << ' ' << it->first;
+  std::cout << '\n';
+}
+
+static void test_range_build(void) {
+  ft::vector<ft::pair<int, int> > sorted;
+  for (int i = 0; i < 100; i++) sorted.push_back(ft::make_pair(i * 3, i));
+
+  ft::map<int, int> built(sorted.begin(), sorted.end());  // sorted & unique, built in one go
+  ft::map<int, int> copy(built.begin(), built.end());
+  copy.erase(30);
+  copy.insert(ft::make_pair(31, -1));
+  copy[1] = 1;
+
+  ft::vector<ft::pair<int, int> > unsorted(sorted.rbegin(), sorted.rend());
+  unsorted.push_back(ft::make_pair(0, -1));  // an existing key
+  ft::map<int, int> other(unsorted.begin(), unsorted.end());
+  other.insert(sorted.begin(), sorted.end());  // not empty anymore
+
+  std::cout << "size: " << built.size() << " " << copy.size() << " " << other.size() << '\n';
+  std::cout << "0 => " << other[0] << ", 297 => " << built[297] << '\n';
+  for (ft::map<int, int>::iterator it = copy.begin(); it != copy.end() && it->first < 40; it++) std::cout << ' ' << it->first;
+  std::cout << '\n';
+}
+
+static void test_copy_clone(void) {
+  ft::map<int, std::string> big, small;
+
+  for (int i = 0; i < 500; i++) big[(i * 263) % 500] = std::string(i % 20, 'b');
+  for (int i = 0; i < 10; i++) small[i * 100] = "small";
+
+  ft::map<int, std::string> copy(big);
+  ft::map<int, std::string> grown(small);
+  grown = big;  // 10 nodes reused, the others allocated
+  copy = small;  // 10 nodes reused, the others freed
+  copy = copy;
+
+  grown.erase(250);
+  grown[1000] = "new";
+  copy.insert(ft::make_pair(50, "fifty"));
+  std::cout << "size: " << big.size() << " " << grown.size() << " " << copy.size() << '\n';
+  std::cout << "grown: " << grown.begin()->first << " " << grown.rbegin()->first << " " << grown[499] << '\n';
+  for (ft::map<int, std::string>::iterator it = copy.begin(); it != copy.end(); it++) std::cout << it->first << " => " << it->second << '\n';
+}
+
+static void test_transparent_lookup(void) {
+  ft::map<std::string, int, transparent_less> mymap;
+
+  mymap["apple"] = 1;
+  mymap["banana"] = 2;
+  mymap["cherry"] = 3;
+
+  const char* probes[] = {"banana", "blueberry", "apple", "zucchini"};
+  for (int i = 0; i < 4; i++) {
+    ft::map<std::string, int, transparent_less>::const_iterator it = mymap.find(probes[i]);
+    std::cout << probes[i] << ": " << (it == mymap.end() ? -1 : it->second) << " count " << mymap.count(probes[i]);
+    std::cout << " lower " << (mymap.lower_bound(probes[i]) == mymap.end() ? "end" : mymap.lower_bound(probes[i])->first);
+    std::cout << " upper " << (mymap.upper_bound(probes[i]) == mymap.end() ? "end" : mymap.upper_bound(probes[i])->first) << '\n';
+  }
+  std::cout << "equal_range: " << mymap.equal_range("cherry").first->second << '\n';
+  std::cout << "key lookup: " << mymap.find(std::string("apple"))->second << " " << mymap.erase("apple") << " " << mymap.size() << '\n';
+}
+
+static void test_range_aggregate(void) {
+  volume_map levels;
+
+  for (int price = 100; price < 200; price += 5) levels.insert(ft::make_pair(price, long(price * 10)));
+  std::cout << "[100, 200): " << volume_between(levels, 100, 200) << ", [120, 150): " << volume_between(levels, 120, 150) << ", [121, 124): " << volume_between(levels, 121, 124)
+            << ", [150, 120): " << volume_between(levels, 150, 120) << '\n';
+
+  levels.erase(levels.find(130));
+  levels.erase(levels.lower_bound(160), levels.lower_bound(175));
+  levels.insert(ft::make_pair(131, 7L));
+  volume_map::iterator level = levels.find(140);
+  level->second += 1000;
+  volume_changed(levels, level);
+  std::cout << "[120, 150): " << volume_between(levels, 120, 150) << ", [0, 1000): " << volume_between(levels, 0, 1000) << ", [140, 141): " << volume_between(levels, 140, 141) << '\n';
+
+  set_volume(levels, 145, 1);
+  set_volume(levels, 146, 2);
+  levels[150] += 500;
+  volume_changed(levels, levels.find(150));
+  std::cout << "[140, 151): " << volume_between(levels, 140, 151) << ", [0, 1000): " << volume_between(levels, 0, 1000) << '\n';
+
+  volume_map copy(levels);
+  copy.clear();
+  std::cout << "empty: " << volume_between(copy, 0, 1000) << '\n';
+}
+
+static void print_words(const char* name, const word_map& words) {
+  std::cout << name << ':';
+  for (word_map::const_iterator it = words.begin(); it != words.end(); ++it) std::cout << ' ' << it->first << '=' << it->second;
+  std::cout << '\n';
+}
+
+static void test_set_algebra(void) {
+  const char* english[] = {"zero", "one", "two", "three", "four", "five", "six", "seven"};
+  const char* french[] = {"zero", "un", "deux", "trois", "quatre", "cinq", "six", "sept"};
+  word_map    en, fr;
+
+  for (int i = 0; i < 8; i += 2) en[i] = english[i];
+  for (int i = 0; i < 8; i += 3) fr[i] = french[i];
+  en[7] = english[7];
+  fr[7] = french[7];
+
+  // on equal keys the elements of the destination stay
+  word_map merged(en), source(fr), united(en), all(fr), inter(en), diff(en);
+  merge_of(merged, source);
+  union_of(united, all);
+  intersection_of(inter, fr);
+  difference_of(diff, fr);
+  print_words("merged", merged);
+  print_words("left in the source", source);
+  print_words("union", united);
+  print_words("intersection", inter);
+  print_words("difference", diff);
+  std::cout << "sizes: " << merged.size() << ' ' << source.size() << ' ' << united.size() << ' ' << all.size() << ' ' << inter.size() << ' ' << diff.size() << '\n';
+
+  merged[5] = "five";
+  merged.erase(0);
+  print_words("merged", merged);
+}
+
+// std has node handles since C++17 only, the std build moves the elements by copy
+#if STD
+static bool move_entry(word_map& dst, word_map& src, int key) {
+  word_map::iterator it = src.find(key);
+
+  if (it == src.end() || dst.count(key)) return false;
+  dst.insert(*it);
+  src.erase(it);
+  return true;
+}
+static bool rename_entry(word_map& words, int from, int to) {
+  word_map::iterator it = words.find(from);
+
+  if (it == words.end() || words.count(to)) return false;
+  std::string word = it->second;
+  words.erase(it);
+  words[to] = word;
+  return true;
+}
+#else
+static bool move_entry(word_map& dst, word_map& src, int key) {
+  word_map::node_type nh = src.extract(key);
+
+  if (nh.empty()) return false;
+  word_map::insert_return_type ret = dst.insert(FT_MOVE(nh));
+  // the node is given back when the key is already there
+  if (!ret.inserted) src.insert(FT_MOVE(ret.node));
+  return ret.inserted;
+}
+static bool rename_entry(word_map& words, int from, int to) {
+  word_map::node_type nh = words.extract(from);
+
+  if (nh.empty()) return false;
+  nh.key() = to;
+  word_map::insert_return_type ret = words.insert(FT_MOVE(nh));
+  if (!ret.inserted) {
+    ret.node.key() = from;
+    words.insert(FT_MOVE(ret.node));
+  }
+  return ret.inserted;
+}
+#endif
+
+static void test_node_handles(void) {
+  word_map shard, other;
+
+  for (int i = 0; i < 10; i++) shard[i] = std::string(i + 1, 'a' + i);
+  other[3] = "three";
+
+  std::cout << "moved:";
+  for (int i = 0; i < 12; i += 2) std::cout << ' ' << move_entry(other, shard, i);
+  std::cout << "\nmoved back: " << move_entry(shard, other, 3) << ' ' << move_entry(shard, other, 4) << '\n';
+  std::cout << "renamed: " << rename_entry(shard, 5, 50) << ' ' << rename_entry(shard, 7, 1) << ' ' << rename_entry(shard, 42, 43) << '\n';
+  print_words("shard", shard);
+  print_words("other", other);
+
+  // the moved nodes outlive the map they came from
+  for (int round = 0; round < 3; round++) {
+    word_map tmp;
+    for (int i = 100; i < 200; i++) tmp[i] = "tmp";
+    for (int i = 100; i < 200; i += 10) move_entry(other, tmp, i + round);
+  }
+  other.erase(0);
+  std::cout << "other: " << other.size() << ' ' << other.begin()->first << ' ' << other.rbegin()->first << '\n';
+  shard.clear();
+  other.clear();
+  std::cout << "cleared: " << shard.size() << ' ' << other.size() << '\n';
+}
+
+// many nodes reused after erase & clear (the tree nodes come from a pool)
+static void test_node_reuse(void) {
+  ft::map<int, std::string> mymap;
+
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 1000; i++) mymap[(i * 7919) % 1000] = std::string(i % 50, 'x');
+    for (int i = 0; i < 1000; i += 3) mymap.erase(i);
+
+    ft::map<int, std::string> copy(mymap);
+    for (int i = 0; i < 1000; i += 2) copy.erase(i);
+    std::cout << "round " << round << ": " << mymap.size() << " " << copy.size() << " " << copy.begin()->first << " " << copy.rbegin()->first << '\n';
+
+    mymap.clear();
+    std::cout << "cleared: " << mymap.size() << " " << (mymap.begin() == mymap.end()) << '\n';
+  }
+}
+
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+  ft::map<int, std::string> mymap;
+
+  mymap.emplace(2, "two");
+  mymap.emplace(1, std::string(5, 'o'));
+  mymap.insert(ft::map<int, std::string>::value_type(3, "three"));
+  mymap.emplace_hint(mymap.end(), 4, "four");
+  std::cout << "emplace of an existing key: " << mymap.emplace(2, "deux").second << '\n';
+
+  ft::map<int, std::string> moved(std::move(mymap));
+  std::cout << "mymap size: " << mymap.size() << '\n';
+  for (ft::map<int, std::string>::iterator it = moved.begin(); it != moved.end(); ++it) std::cout << it->first << " => " << it->second << '\n';
+
+  mymap = std::move(moved);
+  std::cout << "mymap size: " << mymap.size() << ", moved size: " << moved.size() << '\n';
+}
+#endif
+
 // static void test_relational_operators(void) {}
 
 void map_main() {
@@ -339,16 +804,31 @@ void map_main() {
   start_test("Test size", test_size);
   start_test("Test max_size", test_max_size);
   start_test("Test access element[]", test_access_element);
+  start_test("Test try_emplace", test_try_emplace);
   start_test("Test insert", test_insert);
+  start_test("Test insert hint", test_insert_hint);
+  start_test("Test range build", test_range_build);
+  start_test("Test copy clone", test_copy_clone);
   start_test("Test erase", test_erase);
   start_test("Test swap", test_swap);
+  start_test("Test swap iterators", test_swap_iterators);
+  start_test("Test empty maps", test_empty_maps);
   start_test("Test clear", test_clear);
   start_test("Test key_comp", test_key_comp);
   start_test("Test value_comp", test_value_comp);
   start_test("Test find", test_find);
+  start_test("Test find_many", test_find_many);
   start_test("Test count", test_count);
   start_test("Test lower/upper bound", test_lower_upper_bound);
   start_test("Test equal_range", test_equal_range);
+  start_test("Test transparent lookup", test_transparent_lookup);
   start_test("Test get_allocator", test_get_allocator);
+  start_test("Test node reuse", test_node_reuse);
+  start_test("Test range aggregate", test_range_aggregate);
+  start_test("Test set algebra", test_set_algebra);
+  start_test("Test node handles", test_node_handles);
+#if __cplusplus >= 201103L
+  start_test("Test move semantics", test_move_semantics);
+#endif
   // start_test("Test relational operators", test_relational_operators);
 }
\ No newline at end of file
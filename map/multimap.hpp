@@ -0,0 +1,294 @@
+#ifndef __MULTIMAP_HPP__
+#define __MULTIMAP_HPP__
+
+#include <functional>
+#include <memory>
+
+#include "equal.hpp"
+#include "functional.hpp"
+#include "iterator_traits.hpp"
+#include "lexicographical_compare.hpp"
+#include "move.hpp"
+#include "pair.hpp"
+#include "red_black_tree.hpp"
+
+namespace ft {
+// a map whose keys may repeat : the values of a key are kept in insertion order, next to each other
+template <class Key,                                          // multimap::key_type
+          class T,                                            // multimap::mapped_type
+          class Compare = std::less<Key>,                     // multimap::key_compare
+          class Alloc = std::allocator<pair<const Key, T> >,  // multimap::allocator_type
+          class NodePolicy = ft::compact_node                 // layout of the tree nodes (see node_policy.hpp)
+          >
+class multimap {
+ public:
+  // member types
+  class value_compare;
+  typedef Key                                      key_type;
+  typedef T                                        mapped_type;
+  typedef ft::pair<const key_type, mapped_type>    value_type;
+  typedef Compare                                  key_compare;
+  typedef Alloc                                    allocator_type;
+  typedef typename allocator_type::reference       reference;
+  typedef typename allocator_type::const_reference const_reference;
+  typedef typename allocator_type::pointer         pointer;
+  typedef typename allocator_type::const_pointer   const_pointer;
+
+ private:
+  typedef RedBlackTree<key_type, value_type, ft::select_first<value_type>, key_compare, allocator_type, NodePolicy> RBT;
+  RBT                                                                               tree;
+  allocator_type                                                  _alloc;
+  key_compare                                                     _key_comp;
+  value_compare                                                   _value_comp;
+
+ public:
+  typedef typename RBT::iterator                   iterator;
+  typedef typename RBT::const_iterator             const_iterator;
+  typedef ft::reverse_iterator<iterator>           reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
+  typedef typename allocator_type::difference_type difference_type;
+  typedef typename allocator_type::size_type       size_type;
+
+ public:
+  // the default constructor
+  explicit multimap(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : tree(comp), _alloc(alloc), _key_comp(comp), _value_comp(comp) {}
+
+  // the range constructor
+  template <class InputIterator>
+  multimap(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : tree(comp), _alloc(alloc), _key_comp(comp), _value_comp(comp) {
+    this->insert(first, last);
+  }
+
+  // the copy constructor
+  multimap(const multimap& x) : tree(x.tree), _value_comp(x._value_comp) {
+    this->_alloc = x._alloc;
+    this->_key_comp = x._key_comp;
+    this->_value_comp = x._value_comp;
+  }
+
+  // copy assignment operator
+  multimap& operator=(const multimap& x) {
+    if (this != &x) {
+      this->tree = x.tree;
+    }
+    return *this;
+  }
+
+#if FT_CXX11
+  // move constructor
+  multimap(multimap&& x) : tree(std::move(x.tree)), _alloc(x._alloc), _key_comp(x._key_comp), _value_comp(x._value_comp) {}
+
+  // move assignment operator
+  multimap& operator=(multimap&& x) {
+    if (this != &x) {
+      this->tree = std::move(x.tree);
+    }
+    return *this;
+  }
+#endif
+
+  // Iterators
+  iterator       begin() { return tree.begin(); };
+  const_iterator begin() const { return tree.begin(); };
+
+  iterator       end() { return tree.end(); };
+  const_iterator end() const { return tree.end(); };
+
+  reverse_iterator       rbegin() { return reverse_iterator(this->end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+  reverse_iterator       rend() { return reverse_iterator(this->begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+  // Capacity
+  bool      empty() const { return tree.empty(); }
+  size_type size() const { return tree.size(); }
+  size_type max_size() const { return tree.max_size(); };
+
+  // Modifiers
+
+  iterator insert(const value_type& val) { return iterator(tree.insertEqual(val)); }
+
+  // linked right before the hint without a descent when the value goes there
+  iterator insert(iterator position, const value_type& val) { return iterator(tree.insertEqual(position.base(), val)); }
+
+#if FT_CXX11
+  iterator insert(value_type&& val) { return iterator(tree.insertEqual(std::move(val))); }
+
+  iterator insert(iterator position, value_type&& val) { return iterator(tree.insertEqual(position.base(), std::move(val))); }
+
+  template <class... Args>
+  iterator emplace(Args&&... args) {
+    return iterator(tree.emplaceEqual(std::forward<Args>(args)...));
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator position, Args&&... args) {
+    return iterator(tree.emplaceHintEqual(position.base(), std::forward<Args>(args)...));
+  }
+#endif
+
+  // sorted ranges are built in O(n) in an empty container, the other values are linked one by one
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    tree.insertEqualRange(first, last);
+  }
+
+  // the key erasure finds the range of the key once & unlinks its nodes one after the other, O(log n + count)
+  void      erase(iterator position) { tree.eraseNode(position.base()); }
+  size_type erase(const key_type& k) { return tree.deleteEqual(k); }
+  void      erase(iterator first, iterator last) { tree.eraseRange(first.base(), last.base()); }
+
+  // constant time, no element is copied or moved
+  void swap(multimap& x) {
+    this->tree.swap(x.tree);
+    std::swap(this->_alloc, x._alloc);
+    std::swap(this->_key_comp, x._key_comp);
+    std::swap(this->_value_comp, x._value_comp);
+  }
+
+  void clear() { tree.clear(); }
+
+  // Observers
+  key_compare   key_comp() const { return this->_key_comp; }
+  value_compare value_comp() const { return this->_value_comp; }
+
+  // Operations
+
+  // the first value of the key
+  iterator       find(const key_type& k) { return tree.findFirst(k); }
+  const_iterator find(const key_type& k) const { return tree.findFirst(k); }
+
+  // O(log n + count)
+  size_type count(const key_type& k) const { return tree.countEqual(k); }
+
+  iterator       lower_bound(const key_type& k) { return tree.lower_bound(k); }
+  const_iterator lower_bound(const key_type& k) const { return tree.lower_bound(k); }
+
+  iterator       upper_bound(const key_type& k) { return tree.upper_bound(k); }
+  const_iterator upper_bound(const key_type& k) const { return tree.upper_bound(k); }
+
+  // a single descent for both ends of the range
+  ft::pair<iterator, iterator>             equal_range(const key_type& k) { return tree.equalRange(k); }
+  ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return tree.equalRange(k); }
+
+  // heterogeneous lookups, only with a transparent comparator (declaring `is_transparent`) :
+  // the key is compared as it is, ex: a std::string key with a const char * without building a std::string
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type find(const K& k) {
+    return tree.findFirst(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type find(const K& k) const {
+    return tree.findFirst(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, size_type>::type count(const K& k) const {
+    return tree.countEqual(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type lower_bound(const K& k) {
+    return tree.lower_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type lower_bound(const K& k) const {
+    return tree.lower_bound(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type upper_bound(const K& k) {
+    return tree.upper_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type upper_bound(const K& k) const {
+    return tree.upper_bound(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+    return tree.equalRange(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+    return tree.equalRange(k);
+  }
+
+  // order statistics, only with a NodePolicy counting the nodes (ft::counted_node) : O(log n) without walking the elements
+  iterator        nth(size_type k) { return tree.nth(k); }
+  const_iterator  nth(size_type k) const { return tree.nth(k); }
+  size_type       rank(const key_type& k) const { return tree.rank(k); }  // the number of keys less than k
+  difference_type distance(const_iterator first, const_iterator last) const { return tree.distance(first.base(), last.base()); }
+
+  // range aggregates, only with a NodePolicy summarizing the values by a monoid (ft::augmented_node) :
+  // the combination of the values whose key is in [lo, hi), in O(log n)
+  typedef typename RBT::summary_type summary_type;
+
+  summary_type aggregate(const key_type& lo, const key_type& hi) const { return tree.aggregate(lo, hi); }
+
+  // the summaries follow the insertions & the erasures, a mapped value changed in place must be refreshed (O(log n))
+  void refresh(iterator position) { tree.pullPath(position.base()); }
+
+  // Allocator
+  allocator_type get_allocator() const { return this->_alloc; }
+
+  // void test(void) const { tree.test(); } // dump the tree
+
+  // the multimap destructor
+  ~multimap() {}
+};
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+class multimap<Key, T, Compare, Alloc, NodePolicy>::value_compare
+#if __cplusplus < 201103L
+    : public std::binary_function<value_type, value_type, bool>  // in C++98, it is required to inherit binary_function<value_type,value_type,bool>
+#endif
+{
+  friend class multimap;
+
+ public:
+  Compare comp;
+  value_compare(Compare c) : comp(c) {}  // constructed with multimap's comparison object
+ public:
+  typedef bool       result_type;
+  typedef value_type first_argument_type;
+  typedef value_type second_argument_type;
+  bool               operator()(const value_type& x, const value_type& y) const { return comp(x.first, y.first); }
+};
+
+// relational operators for multimap
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator==(const multimap<Key, T, Compare, Alloc, NodePolicy>& lhs, const multimap<Key, T, Compare, Alloc, NodePolicy>& rhs) {
+  return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator!=(const multimap<Key, T, Compare, Alloc, NodePolicy>& lhs, const multimap<Key, T, Compare, Alloc, NodePolicy>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator<(const multimap<Key, T, Compare, Alloc, NodePolicy>& lhs, const multimap<Key, T, Compare, Alloc, NodePolicy>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator<=(const multimap<Key, T, Compare, Alloc, NodePolicy>& lhs, const multimap<Key, T, Compare, Alloc, NodePolicy>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+bool operator>(const multimap<Key, T, Compare, Alloc, NodePolicy>& lhs, const multimap<Key, T, Compare, Alloc, NodePolicy>& rhs) {
+  return rhs < lhs;
+}
+
+template <class Key, class T, class Compare, class Alloc, class NodePolicy>
+void swap(multimap<Key, T, Compare, Alloc, NodePolicy>& x, multimap<Key, T, Compare, Alloc, NodePolicy>& y) {
+  x.swap(y);
+}
+
+}  // namespace ft
+
+#endif
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "tests.hpp"
+
+typedef ft::multimap<char, int> char_multimap;
+
+static void print(const char* name, const char_multimap& mymap) {
+  std::cout << name << " contains:";
+  for (char_multimap::const_iterator it = mymap.begin(); it != mymap.end(); ++it) std::cout << ' ' << it->first << "=>" << it->second;
+  std::cout << '\n';
+}
+
+static void test_constructor(void) {
+  char_multimap first;
+
+  first.insert(ft::make_pair('a', 10));
+  first.insert(ft::make_pair('b', 15));
+  first.insert(ft::make_pair('b', 20));
+  first.insert(ft::make_pair('c', 25));
+
+  char_multimap second(first.begin(), first.end());
+  char_multimap third(second);
+  char_multimap fourth;
+
+  fourth = third;
+  fourth.insert(ft::make_pair('a', 5));
+  print("first", first);
+  print("third", third);
+  print("fourth", fourth);
+  std::cout << "first == third: " << (first == third) << ", third < fourth: " << (third < fourth) << '\n';
+}
+
+static void test_insert(void) {
+  char_multimap         mymap;
+  char_multimap::iterator it;
+
+  it = mymap.insert(ft::make_pair('b', 1));
+  mymap.insert(ft::make_pair('b', 2));
+  mymap.insert(ft::make_pair('a', 3));
+  mymap.insert(ft::make_pair('c', 4));
+  std::cout << "inserted: " << it->first << "=>" << it->second << '\n';
+
+  // the equal keys keep their insertion order, the hint puts the value right before it when it fits
+  mymap.insert(ft::make_pair('b', 5));
+  mymap.insert(mymap.find('c'), ft::make_pair('b', 6));
+  mymap.insert(mymap.begin(), ft::make_pair('b', 7));
+  mymap.insert(mymap.end(), ft::make_pair('b', 8));
+  mymap.insert(mymap.end(), ft::make_pair('d', 9));
+  mymap.insert(mymap.lower_bound('b'), ft::make_pair('b', 10));
+  print("mymap", mymap);
+
+  // unsorted, sorted & empty ranges
+  ft::pair<char, int> values[] = {ft::make_pair('e', 1), ft::make_pair('a', 2), ft::make_pair('e', 3), ft::make_pair('a', 4)};
+  mymap.insert(values, values + 4);
+  print("mymap", mymap);
+
+  char_multimap sorted;
+  sorted.insert(mymap.begin(), mymap.end());
+  sorted.insert(mymap.begin(), mymap.begin());
+  print("sorted", sorted);
+  std::cout << "size: " << sorted.size() << '\n';
+}
+
+static void test_equal_range(void) {
+  ft::multimap<int, int> mymap;
+
+  // keys 0 to 9, key k comes k times
+  for (int k = 0; k < 10; k++)
+    for (int i = 0; i < k; i++) mymap.insert(ft::make_pair((k * 7) % 10, i));
+
+  for (int k = -1; k <= 10; k++) {
+    ft::pair<ft::multimap<int, int>::iterator, ft::multimap<int, int>::iterator> range = mymap.equal_range(k);
+    std::cout << k << ": " << mymap.count(k) << " [";
+    for (ft::multimap<int, int>::iterator it = range.first; it != range.second; ++it) std::cout << ' ' << it->second;
+    std::cout << " ] " << (range.second == mymap.end() ? -1 : range.second->first) << '\n';
+  }
+
+  const ft::multimap<int, int>& cmap = mymap;
+  std::cout << "const: " << (cmap.equal_range(5).first == cmap.lower_bound(5)) << (cmap.equal_range(5).second == cmap.upper_bound(5)) << '\n';
+}
+
+static void test_erase(void) {
+  ft::multimap<int, int> mymap;
+
+  for (int i = 0; i < 60; i++) mymap.insert(ft::make_pair(i % 6, i));
+
+  std::cout << "erase 3: " << mymap.erase(3);
+  std::cout << ", erase 3: " << mymap.erase(3);
+  std::cout << ", erase 42: " << mymap.erase(42) << '\n';
+  mymap.erase(mymap.find(0));
+  mymap.erase(mymap.lower_bound(1), mymap.upper_bound(2));
+  mymap.erase(mymap.begin(), mymap.begin());
+  std::cout << "size: " << mymap.size() << '\n';
+  for (ft::multimap<int, int>::iterator it = mymap.begin(); it != mymap.end(); ++it) std::cout << ' ' << it->first << ':' << it->second;
+  std::cout << '\n';
+
+  std::cout << "erase 0: " << mymap.erase(0);
+  std::cout << ", erase 4: " << mymap.erase(4);
+  std::cout << ", erase 5: " << mymap.erase(5) << '\n';
+  std::cout << "empty: " << mymap.empty() << '\n';
+  mymap.insert(ft::make_pair(7, 7));
+  mymap.insert(ft::make_pair(7, 8));
+  std::cout << "size: " << mymap.size() << " " << mymap.begin()->second << " " << mymap.rbegin()->second << '\n';
+}
+
+static void test_many_duplicates(void) {
+  ft::multimap<int, int> mymap;
+  long                   sum = 0;
+
+  // a few keys, thousands of values each : inserts, erasures & lookups go through long runs of equal keys
+  for (int i = 0; i < 5000; i++) mymap.insert(ft::make_pair((i * 13) % 5, i));
+  for (ft::multimap<int, int>::iterator it = mymap.begin(); it != mymap.end();) {
+    if (it->second % 3 == 0)
+      mymap.erase(it++);
+    else
+      ++it;
+  }
+  for (int k = 0; k < 5; k++) std::cout << mymap.count(k) << ' ';
+  std::cout << '\n';
+
+  ft::pair<ft::multimap<int, int>::iterator, ft::multimap<int, int>::iterator> range = mymap.equal_range(2);
+  for (ft::multimap<int, int>::iterator it = range.first; it != range.second; ++it) sum += it->second;
+  std::cout << "sum of 2: " << sum << ", first of 2: " << range.first->second;
+  std::cout << ", erase 2: " << mymap.erase(2);
+  std::cout << ", size: " << mymap.size() << '\n';
+
+  ft::multimap<int, int> copy(mymap);
+  mymap.clear();
+  std::cout << "copy: " << copy.size() << " " << copy.count(4) << " " << copy.rbegin()->second << '\n';
+}
+
+static void test_swap(void) {
+  char_multimap foo, bar;
+
+  foo.insert(ft::make_pair('x', 100));
+  foo.insert(ft::make_pair('x', 200));
+  bar.insert(ft::make_pair('a', 11));
+  bar.insert(ft::make_pair('b', 22));
+  bar.insert(ft::make_pair('a', 33));
+
+  char_multimap::iterator it = foo.begin();
+  foo.swap(bar);
+  print("foo", foo);
+  print("bar", bar);
+  std::cout << "iterator moved with its node: " << it->second << '\n';
+}
+
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+  ft::multimap<std::string, std::string> mymap;
+  std::string                            word("word");
+
+  mymap.insert(ft::make_pair(std::string("key"), std::move(word)));
+  mymap.emplace("key", "other");
+  mymap.emplace_hint(mymap.begin(), "key", "first");
+  mymap.emplace_hint(mymap.end(), "a", "b");
+
+  ft::multimap<std::string, std::string> moved(std::move(mymap));
+  std::cout << "mymap size: " << mymap.size() << '\n';
+  std::cout << "moved contains:";
+  for (ft::multimap<std::string, std::string>::iterator it = moved.begin(); it != moved.end(); ++it) std::cout << ' ' << it->first << "=>" << it->second;
+  std::cout << '\n';
+}
+#endif
+
+void multimap_main() {
+  start_test("Test Constructor", test_constructor);
+  start_test("Test insert", test_insert);
+  start_test("Test equal_range", test_equal_range);
+  start_test("Test erase", test_erase);
+  start_test("Test many duplicates", test_many_duplicates);
+  start_test("Test swap", test_swap);
+#if __cplusplus >= 201103L
+  start_test("Test move semantics", test_move_semantics);
+#endif
+}
@@ -0,0 +1,126 @@
+#ifndef __NODE_HANDLE_HPP__
+#define __NODE_HANDLE_HPP__
+
+#include "move.hpp"
+
+namespace ft {
+
+template <typename Key, typename T, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy>
+class RedBlackTree;
+
+// node_handle -> the node of an element taken out of its tree by extract, the element goes into another tree
+// (or back) by insert without being copied nor its node reallocated. the handle owns the node until then :
+// the element is destroyed with the handle when it's not inserted. an empty handle holds nothing.
+// move only in c++11, in c++98 a copy takes the node from its source (like std::auto_ptr).
+template <class Node, class NodeAlloc>
+class node_handle {
+ public:
+  typedef typename Node::value_type value_type;
+
+  node_handle() : _node(nullptr), _alloc() {}
+
+#if FT_CXX11
+  node_handle(node_handle &&other) : _node(other._node), _alloc(other._alloc) { other._node = nullptr; }
+
+  node_handle &operator=(node_handle &&other) {
+    if (this != &other) {
+      this->reset();
+      this->_node = other._node;
+      this->_alloc = other._alloc;
+      other._node = nullptr;
+    }
+    return *this;
+  }
+
+  node_handle(const node_handle &) = delete;
+  node_handle &operator=(const node_handle &) = delete;
+
+  explicit operator bool() const { return this->_node; }
+#else
+  node_handle(const node_handle &other) : _node(other._node), _alloc(other._alloc) { other._node = nullptr; }
+
+  node_handle &operator=(const node_handle &other) {
+    if (this != &other) {
+      this->reset();
+      this->_node = other._node;
+      this->_alloc = other._alloc;
+      other._node = nullptr;
+    }
+    return *this;
+  }
+#endif
+
+  ~node_handle() { this->reset(); }
+
+  bool empty() const { return !this->_node; }
+
+  value_type &value() const { return this->_node->data; }
+
+  void swap(node_handle &other) {
+    Node     *node = this->_node;
+    NodeAlloc alloc = this->_alloc;
+
+    this->_node = other._node;
+    this->_alloc = other._alloc;
+    other._node = node;
+    other._alloc = alloc;
+  }
+
+ protected:
+  template <typename Key, typename T, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy>
+  friend class RedBlackTree;
+
+  // the allocator of the node comes along, to destroy it or to share its pool with the tree it goes to
+  node_handle(Node *node, const NodeAlloc &alloc) : _node(node), _alloc(alloc) {}
+
+  void reset() {
+    if (!this->_node) return;
+    this->_alloc.destroy(this->_node);
+    this->_alloc.deallocate(this->_node, 1);
+    this->_node = nullptr;
+  }
+
+  mutable Node *_node;
+  NodeAlloc     _alloc;
+};
+
+// the node handle of the maps : the key can be changed before the element goes into a map
+template <class Node, class NodeAlloc, class Key, class Mapped>
+class map_node_handle : public node_handle<Node, NodeAlloc> {
+ public:
+  typedef Key    key_type;
+  typedef Mapped mapped_type;
+
+  map_node_handle() {}
+
+  key_type    &key() const { return const_cast<key_type &>(this->_node->data.first); }
+  mapped_type &mapped() const { return this->_node->data.second; }
+
+#if FT_CXX11
+  map_node_handle(map_node_handle &&other) : node_handle<Node, NodeAlloc>(std::move(other)) {}
+
+  map_node_handle &operator=(map_node_handle &&other) {
+    node_handle<Node, NodeAlloc>::operator=(std::move(other));
+    return *this;
+  }
+#endif
+
+ protected:
+  template <typename K, typename T, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy>
+  friend class RedBlackTree;
+
+  map_node_handle(Node *node, const NodeAlloc &alloc) : node_handle<Node, NodeAlloc>(node, alloc) {}
+};
+
+// what insert(node_handle) did : the element of the key (the inserted one or the one already there), whether the
+// node went in, & the node itself when it didn't (the handle is empty otherwise)
+template <class Iterator, class NodeHandle>
+struct insert_return_type {
+  Iterator   position;
+  bool       inserted;
+  NodeHandle node;
+};
+
+}  // namespace ft
+
+#endif
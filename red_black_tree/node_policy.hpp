@@ -0,0 +1,137 @@
+#ifndef __NODE_POLICY_HPP__
+#define __NODE_POLICY_HPP__
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uintptr_t
+
+// node policies of the trees.
+// a policy decides the layout of the links of a node : `links<Base>` holds the left, right & parent pointers
+// (to Base, the node base of the tree) & the color, the parent & the color are only reached through
+// getParent/setParent & getColor/setColor. the links come first in the nodes, before the value.
+// a new node is red (true), like the header of a tree.
+// an augmented policy (`augmented` is true) also keeps a summary of every subtree in the root of the subtree :
+// the tree calls pull(value) on a node whenever its children changed, to recompute its summary from the value
+// of the node & the summaries of its children (the leaves are null). the other policies cost nothing.
+
+namespace ft {
+
+// the color has a byte of its own after the three links (the historical layout), the padding makes it cost a word
+struct plain_node {
+  static const bool augmented = false;
+
+  template <class Base>
+  struct links {
+    Base *left;
+    Base *right;
+
+    links() : left(0), right(0), _parent(0), _color(true) {}
+
+    Base *getParent(void) const { return this->_parent; }
+    void  setParent(Base *parent) { this->_parent = parent; }
+    bool  getColor(void) const { return this->_color; }
+    void  setColor(bool color) { this->_color = color; }
+
+    template <class V>
+    void pull(const V &) {}
+
+   private:
+    Base *_parent;
+    bool  _color;
+  };
+};
+
+// the color is the low bit of the parent pointer (the nodes are aligned like pointers, so that bit is always 0),
+// a word less per node : a ft::map<int, int> node takes 32 bytes instead of 40
+struct compact_node {
+  static const bool augmented = false;
+
+  template <class Base>
+  struct links {
+    Base *left;
+    Base *right;
+
+    links() : left(0), right(0), _parent_color(1) {}
+
+    Base *getParent(void) const { return reinterpret_cast<Base *>(this->_parent_color & ~uintptr_t(1)); }
+    void  setParent(Base *parent) { this->_parent_color = reinterpret_cast<uintptr_t>(parent) | (this->_parent_color & 1); }
+    bool  getColor(void) const { return this->_parent_color & 1; }
+    void  setColor(bool color) { this->_parent_color = (this->_parent_color & ~uintptr_t(1)) | uintptr_t(color); }
+
+    template <class V>
+    void pull(const V &) {}
+
+   private:
+    uintptr_t _parent_color;
+  };
+};
+
+// the links of Links & the number of nodes of the subtree : the trees get order statistics in O(log n)
+// (nth, rank & the distance between two iterators), for a word more per node
+template <class Links = compact_node>
+struct counted_node {
+  static const bool augmented = true;
+
+  template <class Base>
+  struct links : public Links::template links<Base> {
+    size_t count;
+
+    links() : count(1) {}
+
+    static size_t countOf(const Base *x) { return x ? x->count : 0; }
+
+    template <class V>
+    void pull(const V &value) {
+      Links::template links<Base>::pull(value);
+      this->count = countOf(this->left) + 1 + countOf(this->right);
+    }
+  };
+};
+
+// the links of Links & the summary of the values of the subtree by a monoid : the trees combine the values of
+// a key range in O(log n) (aggregate). the Monoid gives the summary of a value & combines two summaries, in order :
+//   struct volume_sum {
+//     typedef long value_type;                                              // the summaries
+//     static long identity(void) { return 0; }                              // the summary of nothing
+//     static long combine(long lhs, long rhs) { return lhs + rhs; }         // lhs comes before rhs
+//     static long of(const ft::pair<const int, long> &v) { return v.second; }  // the summary of one value
+//   };
+template <class Monoid, class Links = compact_node>
+struct augmented_node {
+  static const bool augmented = true;
+
+  template <class Base>
+  struct links : public Links::template links<Base> {
+    typename Monoid::value_type summary;
+
+    links() : summary(Monoid::identity()) {}
+
+    static typename Monoid::value_type summaryOf(const Base *x) { return x ? x->summary : Monoid::identity(); }
+
+    template <class V>
+    void pull(const V &value) {
+      Links::template links<Base>::pull(value);
+      this->summary = Monoid::combine(Monoid::combine(summaryOf(this->left), Monoid::of(value)), summaryOf(this->right));
+    }
+  };
+};
+
+// summary_of -> the monoid of a node policy & the type of its summaries, void for the policies without one.
+
+template <class Policy>
+struct summary_of {
+  typedef void monoid_type;
+  typedef void type;
+};
+
+template <class Monoid, class Links>
+struct summary_of<augmented_node<Monoid, Links> > {
+  typedef Monoid                      monoid_type;
+  typedef typename Monoid::value_type type;
+};
+
+template <class Links>
+struct summary_of<counted_node<Links> > : public summary_of<Links> {};
+
+}  // namespace ft
+
+#endif
@@ -2,12 +2,14 @@
 #define __RBT_ITERATOR_HPP__
 
 #include "iterator.hpp"
+#include "move.hpp"
 
 namespace ft {
 
 template <typename T>
 class tree_iterator : ft::iterator<ft::bidirectional_iterator_tag, typename T::value_type> {
-  T* node;
+  // a node of type T, or the header of the tree (the end) which has no value
+  typename T::base_ptr node;
 
  public:
   typedef typename T::value_type                                                               value_type;
@@ -18,12 +20,15 @@ class tree_iterator : ft::iterator<ft::bidirectional_iterator_tag, typename T::v
 
   tree_iterator() : node(nullptr){};
 
-  tree_iterator(T* _node) : node(_node) {}
+  tree_iterator(typename T::base_ptr _node) : node(_node) {}
 
   tree_iterator(const tree_iterator& copy) : node(copy.node) {}
 
   virtual ~tree_iterator() {}
 
+  // the node under the iterator
+  typename T::base_ptr base() const { return this->node; }
+
   tree_iterator& operator=(const tree_iterator& rhs) {
     if (*this != rhs) {
       this->node = rhs.node;
@@ -35,9 +40,9 @@ class tree_iterator : ft::iterator<ft::bidirectional_iterator_tag, typename T::v
 
   bool operator!=(const tree_iterator& rhs) const { return (this->node != rhs.node); }
 
-  reference operator*() const { return (reference)(this->node->data); }
+  reference operator*() const { return (reference)(static_cast<T*>(this->node)->data); }
 
-  pointer operator->() const { return (pointer)(&this->node->data); }
+  pointer operator->() const { return (pointer)(&static_cast<T*>(this->node)->data); }
 
   tree_iterator& operator++(void) {
     this->node = T::getSuccessor(this->node);
@@ -0,0 +1,146 @@
+#ifndef __RBT_NODE_HPP__
+#define __RBT_NODE_HPP__
+
+// let's assume that the true value is red & the false value is black
+
+#define red true
+#define black false
+#define LEFT_SIDE 0
+#define RIGHT_SIDE 1
+
+#include <iostream>
+
+#include "move.hpp"
+#include "node_policy.hpp"
+#include "pair.hpp"
+
+namespace ft {
+
+// the links of a node, without its value : the leaves are null pointers & the header of the tree (its end node)
+// is a NodeBase member of the tree, so an empty tree owns no node at all.
+// the header is red, its parent is the root, its left & right links are the leftmost & the rightmost nodes.
+// the layout of the links comes from the node policy (see node_policy.hpp).
+template <class Policy>
+class NodeBase : public Policy::template links<NodeBase<Policy> > {
+ public:
+  typedef NodeBase *base_ptr;
+
+  static base_ptr getMinimum(base_ptr tree) {
+    while (tree->left) tree = tree->left;
+    return tree;
+  }
+
+  static base_ptr getMaximum(base_ptr tree) {
+    while (tree->right) tree = tree->right;
+    return tree;
+  }
+
+  // climbing from the rightmost node ends on the header : it's the end of the tree
+  static base_ptr getSuccessor(base_ptr x) {
+    if (x->right) return getMinimum(x->right);
+
+    base_ptr y = x->getParent();
+    while (x == y->right) {
+      x = y;
+      y = y->getParent();
+    }
+    // when the root is the rightmost node, x is the header & y the root here
+    return x->right != y ? y : x;
+  }
+
+  // the header is the only red node whose grandparent is itself, its predecessor is the rightmost node
+  static base_ptr getPredecessor(base_ptr x) {
+    if (x->isRed() && x->getParent() && x->getParent()->getParent() == x) return x->right;
+    if (x->left) return getMaximum(x->left);
+
+    base_ptr y = x->getParent();
+    while (x == y->left) {
+      x = y;
+      y = y->getParent();
+    }
+    return y;
+  }
+
+  base_ptr getSide(short side) const { return side == LEFT_SIDE ? this->left : this->right; }
+
+  bool isRed(void) const { return this->getColor() == red; }
+  bool isBlack(void) const { return this->getColor() == black; }
+
+  // the leaves are black
+  static bool isRed(base_ptr x) { return x && x->isRed(); }
+  static bool isBlack(base_ptr x) { return !isRed(x); }
+};
+
+template <class T, class Policy>
+class Node : public NodeBase<Policy> {
+ public:
+  typedef T                         value_type;
+  typedef Node<value_type, Policy> *pointer;
+  typedef const pointer             const_pointer;
+  typedef NodeBase<Policy>          base_type;
+  typedef typename base_type::base_ptr base_ptr;
+
+  // members;
+  T data;
+
+  Node(const T &data) : base_type(), data(data) {}
+
+#if !FT_CXX11
+  // the value of a map built from its key & a factory of its mapped value (see ft::make_second_t)
+  template <class K, class Factory>
+  Node(const K &k, const Factory &make, make_second_t tag) : base_type(), data(k, make, tag) {}
+#endif
+
+#if FT_CXX11
+  // tag of the constructor building `data` in place from the arguments of emplace
+  struct emplace_tag {};
+
+  template <class... Args>
+  Node(emplace_tag, Args &&...args) : base_type(), data(std::forward<Args>(args)...) {}
+#endif
+
+  static const T &valueOf(base_ptr x) { return static_cast<pointer>(x)->data; }
+
+  static void label(base_ptr node, int &id, std::ostream &stream) {
+    stream << "\tNode" << id << "[label=\"";
+    if (node)
+      stream << valueOf(node);
+    else
+      stream << "NIL";
+    stream << "\""
+           << ", fillcolor=\"" << (base_type::isRed(node) ? "red" : "black") << "\""
+           << ", color=\"black\""
+           << ", shape=" << (!node ? "record" : "circle") << ", fixedsize=true"
+           << ", fontcolor=\"white\""
+           << ", tooltip=\"The parent node is " << (node ? node->getParent() : nullptr) << "\""
+           << ", style=filled" << (!node ? ", width=0.3, height=0.2, fontsize=10" : ", fontsize=20") << "]\n";
+  }
+  static void edge(int from, int to, std::ostream &stream) {
+    stream << "\tNode" << from << " -> "
+           << "Node" << to << "[wieght=10]\n";
+  }
+
+  static int dfs(base_ptr tree, int &id, std::ostream &stream) {
+    int my_id, l, r;
+    my_id = id++;
+    label(tree, my_id, stream);
+    if (tree) {
+      l = dfs(tree->left, id, stream);
+      r = dfs(tree->right, id, stream);
+      edge(my_id, l, stream);
+      edge(my_id, r, stream);
+    }
+    return my_id;
+  }
+
+  static void dump_dot(base_ptr tree, std::ostream &stream) {
+    int id = 1;
+    stream << "digraph {\n";
+    dfs(tree, id, stream);
+    stream << "}\n";
+  }
+};
+
+}  // namespace ft
+
+#endif
@@ -1,169 +1,52 @@
 #ifndef __RED_BLACK_TREE_HPP__
 #define __RED_BLACK_TREE_HPP__
 
-// let's assume that the true value is red & the false value is black
-
-#define red true
-#define black false
-#define LEFT_SIDE 0
-#define RIGHT_SIDE 1
-
 using namespace std;
 
 #include <iostream>
 
+#include "functional.hpp"
+#include "move.hpp"
+#include "node_handle.hpp"
 #include "pair.hpp"
+#include "pool_allocator.hpp"
 #include "rbt_iterator.hpp"
+#include "rbt_node.hpp"
 #include "reverse_iterator.hpp"
+#include "thread_pool.hpp"
 
 namespace ft {
 
-template <class T>
-class Node {
- public:
-  typedef T                 value_type;
-  typedef Node<value_type> *pointer;
-  typedef const pointer     const_pointer;
-
-  // members;
-  T       data;
-  pointer left;
-  pointer right;
-  pointer parent;
-  bool    color;
-
-  Node(const T &data, pointer parent = nullptr, bool color = red) : data(data), left(nullptr), right(nullptr), parent(parent), color(color) {}
-
-  static pointer getMinimum(const_pointer tree) {
-    pointer min = tree;
-
-    while (!min->left->isNil()) {
-      min = min->left;
-    }
-    return min;
-  }
-
-  static pointer getMaximum(const_pointer tree) {
-    pointer max = tree;
-
-    while (!max->right->isNil()) {
-      max = max->right;
-    }
-    return max;
-  }
-
-  static pointer getSuccessor(pointer x) {
-    if (!x->right->isNil()) return getMinimum(x->right);
-
-    pointer y = x->parent;
-    while (!y->isNil() && y->right == x) {
-      x = y;
-      y = y->parent;
-    }
-    return y;
-  }
-
-  static pointer getPredecessor(pointer x) {
-    if (!x->left->isNil()) return getMaximum(x->left);
-
-    pointer y = x->parent;
-    while (!y->isNil() && y->left == x) {
-      x = y;
-      y = y->parent;
-    }
-    return y;
-  }
-
-  template <typename Compare>
-  static pointer find(const pointer tree, const value_type &val, Compare comp = Compare()) {
-    pointer tmp = tree;
-
-    while (!tmp->isNil()) {
-      if (comp(val, tmp->data))
-        tmp = tmp->left;
-      else if (comp(tmp->data, val))
-        tmp = tmp->right;
-      else
-        return tmp;
-    }
-
-    return tmp;
-  }
-
-  pointer getSide(short side) const { return side == LEFT_SIDE ? this->left : this->right; }
-  pointer getParent(void) const { return this->parent; }
-  pointer getGrandParent(void) const { return this->getParent()->getParent(); }
-  pointer getSibling(void) const { return this->isLeftChild() ? this->getParent()->right : this->isRightChild() ? this->getParent()->left : nullptr; }
-  pointer getUncle(void) const { return this->getGrandParent() ? (this->getParent()->isLeftChild() ? this->getGrandParent()->right : this->getGrandParent()->left) : nullptr; }
-
-  bool isLeftChild(void) const { return this->getParent() && this == this->getParent()->left; }
-  bool isRightChild(void) const { return this->getParent() && this == this->getParent()->right; }
-  bool isRed(void) const { return this->color == red; }
-  bool isBlack(void) const { return this->color == black; }
-  bool isNil(void) const { return this != nullptr && this->left == nullptr && this->right == nullptr; }
-
-  static void label(pointer node, int &id, ostream &stream) {
-    if (!node) return;
-    stream << "\tNode" << id << "[label=\"" << node << "\""
-           << ", fillcolor=\"" << (node->isRed() ? "red" : "black") << "\""
-           << ", color=\"black\""
-           << ", shape=" << (node->isNil() ? "record" : "circle") << ", fixedsize=true"
-           << ", fontcolor=\"white\""
-           << ", tooltip=\"The parent node is " << node->parent << "\""
-           << ", style=filled" << (node->isNil() ? ", width=0.3, height=0.2, fontsize=10" : ", fontsize=20") << "]\n";
-  }
-  static void edge(int from, int to, ostream &stream) {
-    stream << "\tNode" << from << " -> "
-           << "Node" << to << "[wieght=10]\n";
-  }
-
-  static int dfs(pointer tree, int &id, ostream &stream) {
-    int my_id, l, r;
-    my_id = id++;
-    label(tree, my_id, stream);
-    if (tree) {
-      l = dfs(tree->left, id, stream);
-      r = dfs(tree->right, id, stream);
-      if (!tree->isNil()) {
-        edge(my_id, l, stream);
-        edge(my_id, r, stream);
-      }
-    }
-    return my_id;
-  }
-
-  static void dump_dot(pointer tree, ostream &stream) {
-    int id = 1;
-    stream << "digraph {\n";
-    dfs(tree, id, stream);
-    stream << "}\n";
-  }
-};
-
 template <typename U, typename V>
 std::ostream &operator<<(std::ostream &stream, ft::pair<U, V> pr) {
   stream << pr.first;
   return stream;
 }
 
-template <typename T>
-std::ostream &operator<<(std::ostream &stream, Node<T> *node) {
-  if (node && !node->isNil())
+template <typename T, typename Policy>
+std::ostream &operator<<(std::ostream &stream, Node<T, Policy> *node) {
+  if (node)
     stream << node->data;
   else
     stream << "NIL";
   return stream;
 }
 
-template <typename T, typename Compare, typename Alloc>
+// the tree stores values of type T & orders them on their key, extracted by KeyOfValue (ft::identity or ft::select_first),
+// NodePolicy is the layout of the links of its nodes (ft::compact_node or ft::plain_node)
+template <typename Key, typename T, typename KeyOfValue, typename Compare, typename Alloc, typename NodePolicy = ft::compact_node>
 class RedBlackTree {
  public:
   // member types
+  typedef Key                                                        key_type;
   typedef T                                                          value_type;
-  typedef Node<value_type>                                           node_type;
+  typedef Node<value_type, NodePolicy>                               node_type;
+  typedef NodeBase<NodePolicy>                                       base_type;
+  typedef typename base_type::base_ptr                               base_ptr;
   typedef Alloc                                                      allocator_type;
-  typedef typename allocator_type::template rebind<node_type>::other node_alloc;
-  typedef RedBlackTree<value_type, Compare, node_alloc>              tree;
+  typedef typename allocator_type::template rebind<node_type>::other base_node_alloc;
+  typedef typename ft::conditional<ft::use_node_pool<Alloc>::value, ft::pool_allocator<node_type, base_node_alloc>, base_node_alloc>::type node_alloc;
+  typedef RedBlackTree<key_type, value_type, KeyOfValue, Compare, Alloc, NodePolicy> tree;
   typedef typename node_alloc::reference                             reference;
   typedef typename node_alloc::const_reference                       const_reference;
   typedef typename node_alloc::pointer                               pointer;
@@ -174,54 +57,150 @@ class RedBlackTree {
   typedef ft::reverse_iterator<const_iterator>                       const_reverse_iterator;
   typedef typename node_alloc::difference_type                       difference_type;
   typedef typename node_alloc::size_type                             size_type;
+  typedef typename ft::summary_of<NodePolicy>::type                 summary_type;  // void without a monoid
+  typedef typename ft::summary_of<NodePolicy>::monoid_type          monoid_type;
 
  private:
-  pointer    _root;
+  // the end node : its parent is the root, its left & right links are the leftmost & the rightmost nodes
+  // (rotations keep the in-order sequence, so only links & unlinks change them)
+  base_type  _header;
   size_type  _size;
   node_alloc _alloc;
   Compare    _comp;
 
-  pointer _end;
-  pointer _nil;
-
  public:
-  // The default constructor creates an empty container, with no elements.
-  RedBlackTree(const Compare &comp) : _size(0), _comp(comp) { this->init(); };
-
-  void init(void) {
-    this->_end = this->_alloc.allocate(1);
-    this->_alloc.construct(this->_end, value_type());
-
-    this->_nil = this->_alloc.allocate(1);
-    this->_alloc.construct(this->_nil, value_type());
-    this->_nil->color = black;
+  // The default constructor creates an empty container, with no elements (& allocates nothing).
+  RedBlackTree(const Compare &comp) : _size(0), _comp(comp) { this->resetHeader(); };
+
+  // no root, the extremes are the header itself so begin() == end()
+  void resetHeader(void) {
+    this->_header.setParent(nullptr);
+    this->_header.left = &this->_header;
+    this->_header.right = &this->_header;
+    this->_header.setColor(red);
+  }
 
-    this->_root = this->_nil;
+  // the links of the header came from another tree : the root must hang under this header
+  void fixHeader(void) {
+    if (this->getRoot())
+      this->getRoot()->setParent(&this->_header);
+    else
+      this->resetHeader();
   }
 
-  RedBlackTree(const RedBlackTree &copy) : _comp(copy._comp) {
-    this->init();
+  base_ptr endNode(void) const { return const_cast<base_ptr>(&this->_header); }
+  base_ptr getRoot(void) const { return this->_header.getParent(); }
+
+  RedBlackTree(const RedBlackTree &copy) : _size(0), _comp(copy._comp) {
+    this->resetHeader();
     *this = copy;
   }
 
+  // the copy clones the shape & the colors of `rhs` in O(n) without a single comparison,
+  // the nodes of the destination are reused before new ones are allocated
   RedBlackTree &operator=(const RedBlackTree &rhs) {
     if (this != &rhs) {
-      this->clear();
+      base_ptr reuse = nullptr;
 
-      const_iterator it = rhs.begin();
-      while (it != rhs.end()) {
-        this->insert(*it);
-        it++;
+      this->collectNodes(this->getRoot(), reuse);
+      this->resetHeader();
+      if (!rhs.empty()) {
+        this->_header.setParent(this->cloneSubtree(rhs.getRoot(), &this->_header, reuse));
+        this->updateExtremes();
+      }
+      this->_size = rhs._size;
+      this->_comp = rhs._comp;
+      while (reuse) {
+        base_ptr next = reuse->right;
+        this->destroyNode(reuse);
+        reuse = next;
       }
     }
     return *this;
   }
 
-  virtual ~RedBlackTree() {
-    this->clearNode(this->_end, true);
-    if (this->size()) this->clearNode(this->_root);
-    this->clearNode(this->_nil, true);
-  };
+  // link the nodes of the subtree in a list through their right pointer
+  void collectNodes(base_ptr node, base_ptr &list) {
+    if (!node) return;
+
+    this->collectNodes(node->left, list);
+    this->collectNodes(node->right, list);
+    node->right = list;
+    list = node;
+  }
+
+  // recursion on the right children, loop on the left ones
+  base_ptr cloneSubtree(base_ptr src, base_ptr parent, base_ptr &reuse) {
+    base_ptr top = this->cloneNode(src, parent, reuse);
+
+    if (src->right) top->right = this->cloneSubtree(src->right, top, reuse);
+    for (parent = top, src = src->left; src; src = src->left) {
+      base_ptr z = this->cloneNode(src, parent, reuse);
+
+      parent->left = z;
+      if (src->right) z->right = this->cloneSubtree(src->right, z, reuse);
+      parent = z;
+    }
+    if (NodePolicy::augmented)
+      for (; parent != top->getParent(); parent = parent->getParent()) this->pull(parent);
+    return top;
+  }
+
+  base_ptr cloneNode(base_ptr src, base_ptr parent, base_ptr &reuse) {
+    pointer z = static_cast<pointer>(reuse);
+
+    if (z) {
+      reuse = z->right;
+      this->destroyValue(z);
+      this->constructNode(z, node_type::valueOf(src));
+    } else
+      z = this->createNode(node_type::valueOf(src));
+    z->setColor(src->getColor());
+    z->setParent(parent);
+    z->left = nullptr;
+    z->right = nullptr;
+    return z;
+  }
+
+#if FT_CXX11
+  // move constructor, steals the nodes (with their pool) & leaves `other` empty
+  RedBlackTree(RedBlackTree &&other) : _size(0), _alloc(other._alloc), _comp(other._comp) {
+    this->resetHeader();
+    this->swapHeader(other);
+    std::swap(this->_size, other._size);
+    other._alloc = node_alloc();
+  }
+
+  RedBlackTree &operator=(RedBlackTree &&rhs) {
+    if (this != &rhs) {
+      this->clear();
+      this->swap(rhs);
+    }
+    return *this;
+  }
+#endif
+
+  // the nodes stay where they are, so the iterators stay valid (they move to the other tree with their node),
+  // except end() : the header belongs to its tree
+  void swap(RedBlackTree &x) {
+    this->swapHeader(x);
+    std::swap(this->_size, x._size);
+    std::swap(this->_alloc, x._alloc);
+    std::swap(this->_comp, x._comp);
+  }
+
+  void swapHeader(RedBlackTree &x) {
+    base_ptr root = this->getRoot();
+
+    this->_header.setParent(x.getRoot());
+    x._header.setParent(root);
+    std::swap(this->_header.left, x._header.left);
+    std::swap(this->_header.right, x._header.right);
+    this->fixHeader();
+    x.fixHeader();
+  }
+
+  virtual ~RedBlackTree() { this->clear(); };
 
   // capacity functions
   bool      empty() const { return !this->size(); }
@@ -230,46 +209,50 @@ class RedBlackTree {
 
   allocator_type get_allocator() const { return this->_alloc; }
 
+  // every node goes back to the pool, then the pool gives its chunks back to the allocator at once.
+  // when the tree holds every live node of its pool, the nodes are dropped with the chunks instead of being
+  // deallocated one by one, & they're not even visited when the values have nothing to destroy.
   void clear() {
-    this->clearNode(this->_root);
-    this->_root = this->_nil;
+    size_type dropped = ft::pool_holds_only(this->_alloc, this->_size) ? this->_size : 0;
+
+    if (!dropped || !ft::is_trivially_destructible<value_type>::value) this->destroySubtree(this->getRoot(), !dropped);
+    this->resetHeader();
     this->_size = 0;
+    ft::release_pool(this->_alloc, dropped);
   }
 
-  void clearNode(pointer node, bool deleteOne = false) {
-    if (node->isNil()) return;
+  // iterative with a constant stack : a left child is rotated over its parent until the top node has no left child,
+  // then that node is destroyed & the walk goes on with its right child (the tree is broken up on the way)
+  void destroySubtree(base_ptr x, bool deallocate) {
+    while (x) {
+      base_ptr y = x->left;
 
-    pointer left = node->left;
-    pointer right = node->right;
-    this->_alloc.destroy(node);
-    this->_alloc.deallocate(node, 1);
-    if (!deleteOne) {
-      clearNode(left, deleteOne);
-      clearNode(right, deleteOne);
+      if (y) {
+        x->left = y->right;
+        y->right = x;
+      } else {
+        y = x->right;
+        this->destroyValue(x);
+        if (deallocate) this->_alloc.deallocate(static_cast<pointer>(x), 1);
+      }
+      x = y;
     }
   }
 
-  void unset_end(void) {
-    if (!this->_root->isNil()) {
-      this->_root->parent = nullptr;
-      this->_end->left = nullptr;
-    }
-  }
+  void updateExtremes(void) {
+    if (!this->getRoot()) return this->resetHeader();
 
-  void set_end(void) {
-    if (!this->_root->isNil()) {
-      this->_root->parent = this->_end;
-      this->_end->left = this->_root;
-    }
+    this->_header.left = base_type::getMinimum(this->getRoot());
+    this->_header.right = base_type::getMaximum(this->getRoot());
   }
 
   // iterator
 
-  iterator       begin() { return iterator(this->size() ? this->getMinimum() : this->_end); }
-  const_iterator begin() const { return const_iterator(this->size() ? this->getMinimum() : this->_end); }
+  iterator       begin() { return iterator(this->_header.left); }
+  const_iterator begin() const { return const_iterator(this->_header.left); }
 
-  iterator       end() { return iterator(this->_end); }
-  const_iterator end() const { return const_iterator(this->_end); }
+  iterator       end() { return iterator(this->endNode()); }
+  const_iterator end() const { return const_iterator(this->endNode()); }
 
   reverse_iterator       rbegin() { return reverse_iterator(this->end()); }
   const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
@@ -279,48 +262,472 @@ class RedBlackTree {
 
   // red black tree functions
 
-  ft::pair<bool, pointer> insertUnique(const value_type &val) {
-    pointer exists = this->find(val);  // idea -> improve find function to return pair of bool & pointer
-    if (!exists->isNil()) return ft::make_pair(false, exists);
+#if FT_CXX11
+  template <class... Args>
+  pointer createNode(Args &&...args) {
+    return this->constructNode(this->_alloc.allocate(1), std::forward<Args>(args)...);
+  }
 
-    return ft::make_pair(true, this->insert(val));
+  // build the node in the storage `z`
+  template <class... Args>
+  pointer constructNode(pointer z, Args &&...args) {
+    this->_alloc.construct(z, typename node_type::emplace_tag(), std::forward<Args>(args)...);
+    return z;
   }
+#else
+  pointer createNode(const value_type &val) { return this->constructNode(this->_alloc.allocate(1), val); }
 
-  pointer insert(const value_type &val) {
-    // check if the val already exists !
-    this->unset_end();
-    pointer z = this->_alloc.allocate(red);
+  pointer constructNode(pointer z, const value_type &val) {
     this->_alloc.construct(z, val);
-    z->left = this->_nil;
-    z->right = this->_nil;
-    pointer y = nullptr;
-    pointer x = this->_root;
-
-    // find the right position to put z
-    while (!x->isNil()) {
-      y = x;  // track the parent
-      if (this->_comp(z->data, x->data))
+    return z;
+  }
+#endif
+
+  void destroyNode(base_ptr node) {
+    this->destroyValue(node);
+    this->_alloc.deallocate(static_cast<pointer>(node), 1);
+  }
+
+  // the node holds nothing else than its value, there's no call at all when the value has no destructor
+  void destroyValue(base_ptr node) {
+    if (!ft::is_trivially_destructible<value_type>::value) this->_alloc.destroy(static_cast<pointer>(node));
+  }
+
+  // where a value goes in the tree : the node to link it under & the side, or the node of an equal value
+  struct insert_position {
+    base_ptr parent;
+    short    side;
+    bool     exists;
+  };
+
+  // single descent with one comparison per level, the last node we went right from is the in-order
+  // predecessor of the position, one more comparison with it tells if the value is already there
+  insert_position findUniquePosition(const value_type &val) const { return this->findKeyPosition(keyOf(val)); }
+
+  insert_position findKeyPosition(const key_type &k) const {
+    insert_position pos = {nullptr, LEFT_SIDE, false};
+    base_ptr        x = this->getRoot();
+    base_ptr        prev = nullptr;
+
+    while (x) {
+      pos.parent = x;
+      if (this->_comp(k, keyOf(x))) {
+        pos.side = LEFT_SIDE;
         x = x->left;
-      else
+      } else {
+        pos.side = RIGHT_SIDE;
+        prev = x;
         x = x->right;
+      }
     }
+    if (prev && !this->_comp(keyOf(prev), k)) {
+      pos.parent = prev;
+      pos.exists = true;
+    }
+    return pos;
+  }
+
+  // same with a hint : when `val` goes right before or right after `hint` it's linked next to it without a descent,
+  // a wrong hint costs two comparisons before falling back to the descent
+  insert_position findUniquePosition(base_ptr hint, const value_type &val) const { return this->findKeyPosition(hint, keyOf(val)); }
+
+  insert_position findKeyPosition(base_ptr hint, const key_type &k) const {
+    if (hint == this->endNode() && this->size()) hint = this->_header.right;
+    if (!hint || hint == this->endNode()) return this->findKeyPosition(k);
+
+    insert_position pos = {hint, LEFT_SIDE, false};
+    if (this->_comp(k, keyOf(hint))) {
+      base_ptr before = hint == this->_header.left ? nullptr : this->prevNode(hint);
+      if (before && !this->_comp(keyOf(before), k)) return this->findKeyPosition(k);
+      if (hint->left) {
+        // the predecessor is the maximum of the left subtree, its right side is free
+        pos.parent = before;
+        pos.side = RIGHT_SIDE;
+      }
+    } else if (this->_comp(keyOf(hint), k)) {
+      base_ptr after = hint == this->_header.right ? nullptr : this->nextNode(hint);
+      if (after && !this->_comp(k, keyOf(after))) return this->findKeyPosition(k);
+      pos.side = RIGHT_SIDE;
+      if (hint->right) {
+        pos.parent = after;
+        pos.side = LEFT_SIDE;
+      }
+    } else
+      pos.exists = true;
+    return pos;
+  }
+
+  // in-order neighbours of a node, null at the ends of the tree
+  base_ptr prevNode(base_ptr x) const {
+    if (x->left) return base_type::getMaximum(x->left);
+    while (x != this->getRoot() && x == x->getParent()->left) x = x->getParent();
+    return x == this->getRoot() ? nullptr : x->getParent();
+  }
+
+  base_ptr nextNode(base_ptr x) const {
+    if (x->right) return base_type::getMinimum(x->right);
+    while (x != this->getRoot() && x == x->getParent()->right) x = x->getParent();
+    return x == this->getRoot() ? nullptr : x->getParent();
+  }
+
+  ft::pair<bool, base_ptr> insertUnique(const value_type &val) { return this->insertUnique(nullptr, val); }
 
-    z->parent = y;
-    if (y == nullptr) {
-      this->_root = z;
-    } else if (this->_comp(z->data, y->data)) {
-      y->left = z;
+  ft::pair<bool, base_ptr> insertUnique(base_ptr hint, const value_type &val) {
+    insert_position pos = this->findUniquePosition(hint, val);
+    if (pos.exists) return ft::make_pair(false, pos.parent);
+
+    return ft::make_pair(true, this->linkNode(this->createNode(val), pos.parent, pos.side));
+  }
+
+#if FT_CXX11
+  ft::pair<bool, base_ptr> insertUnique(value_type &&val) { return this->insertUnique(nullptr, std::move(val)); }
+
+  ft::pair<bool, base_ptr> insertUnique(base_ptr hint, value_type &&val) {
+    insert_position pos = this->findUniquePosition(hint, val);
+    if (pos.exists) return ft::make_pair(false, pos.parent);
+
+    return ft::make_pair(true, this->linkNode(this->createNode(std::move(val)), pos.parent, pos.side));
+  }
+
+  // the value is built first to get its key, then dropped if the key already exists
+  template <class... Args>
+  ft::pair<bool, base_ptr> emplaceUnique(Args &&...args) {
+    return this->emplaceHintUnique(nullptr, std::forward<Args>(args)...);
+  }
+
+  template <class... Args>
+  ft::pair<bool, base_ptr> emplaceHintUnique(base_ptr hint, Args &&...args) {
+    pointer         z = this->createNode(std::forward<Args>(args)...);
+    insert_position pos = this->findUniquePosition(hint, z->data);
+    if (pos.exists) {
+      this->destroyNode(z);
+      return ft::make_pair(false, pos.parent);
+    }
+    return ft::make_pair(true, this->linkNode(z, pos.parent, pos.side));
+  }
+#endif
+
+  // the node of the key `k`, or a new node of the key whose mapped value is built from make() : nothing is built
+  // when the key is there, otherwise the value is built once in its node (see ft::make_second_t)
+#if FT_CXX11
+  template <class K, class Factory>
+  ft::pair<bool, base_ptr> tryEmplaceUnique(base_ptr hint, K &&k, const Factory &make) {
+    insert_position pos = this->findKeyPosition(hint, k);
+    if (pos.exists) return ft::make_pair(false, pos.parent);
+
+    return ft::make_pair(true, this->linkNode(this->createNode(std::forward<K>(k), make, ft::make_second_t()), pos.parent, pos.side));
+  }
+#else
+  template <class Factory>
+  ft::pair<bool, base_ptr> tryEmplaceUnique(base_ptr hint, const key_type &k, const Factory &make) {
+    insert_position pos = this->findKeyPosition(hint, k);
+    if (pos.exists) return ft::make_pair(false, pos.parent);
+
+    // the c++98 allocators only copy values, the node is built in place directly
+    pointer z = this->_alloc.allocate(1);
+    try {
+      ::new (static_cast<void *>(z)) node_type(k, make, ft::make_second_t());
+    } catch (...) {
+      this->_alloc.deallocate(z, 1);
+      throw;
+    }
+    return ft::make_pair(true, this->linkNode(z, pos.parent, pos.side));
+  }
+#endif
+
+  // where a value goes among its equals : after the last one (upper), or before the first one (lower)
+  insert_position findEqualPosition(const key_type &k, bool lower) const {
+    insert_position pos = {nullptr, LEFT_SIDE, false};
+    base_ptr        x = this->getRoot();
+
+    while (x) {
+      pos.parent = x;
+      pos.side = (lower ? !this->_comp(keyOf(x), k) : this->_comp(k, keyOf(x))) ? LEFT_SIDE : RIGHT_SIDE;
+      x = x->getSide(pos.side);
+    }
+    return pos;
+  }
+
+  // same with a hint : the value goes right before `hint` when it fits there (or right after it when it's greater),
+  // otherwise after its equals when it's less than the hint & before them when it's greater (like the std trees)
+  insert_position findEqualPosition(base_ptr hint, const value_type &val) const {
+    const key_type &k = keyOf(val);
+    insert_position pos = {hint, LEFT_SIDE, false};
+
+    if (!this->size()) return this->findEqualPosition(k, false);
+    if (hint == this->endNode()) {
+      if (this->_comp(k, keyOf(this->_header.right))) return this->findEqualPosition(k, false);
+      pos.parent = this->_header.right;
+      pos.side = RIGHT_SIDE;
+    } else if (!this->_comp(keyOf(hint), k)) {
+      base_ptr before = hint == this->_header.left ? nullptr : this->prevNode(hint);
+      if (before && this->_comp(k, keyOf(before))) return this->findEqualPosition(k, false);
+      if (hint->left) {
+        pos.parent = before;
+        pos.side = RIGHT_SIDE;
+      }
     } else {
-      y->right = z;
+      base_ptr after = hint == this->_header.right ? nullptr : this->nextNode(hint);
+      if (after && this->_comp(keyOf(after), k)) return this->findEqualPosition(k, true);
+      pos.side = RIGHT_SIDE;
+      if (hint->right) {
+        pos.parent = after;
+        pos.side = LEFT_SIDE;
+      }
+    }
+    return pos;
+  }
+
+  // the equal keys are kept in insertion order : a value without hint goes after its equals
+  base_ptr insertEqual(const value_type &val) {
+    insert_position pos = this->findEqualPosition(keyOf(val), false);
+
+    return this->linkNode(this->createNode(val), pos.parent, pos.side);
+  }
+
+  base_ptr insertEqual(base_ptr hint, const value_type &val) {
+    insert_position pos = this->findEqualPosition(hint, val);
+
+    return this->linkNode(this->createNode(val), pos.parent, pos.side);
+  }
+
+#if FT_CXX11
+  base_ptr insertEqual(value_type &&val) {
+    insert_position pos = this->findEqualPosition(keyOf(val), false);
+
+    return this->linkNode(this->createNode(std::move(val)), pos.parent, pos.side);
+  }
+
+  base_ptr insertEqual(base_ptr hint, value_type &&val) {
+    insert_position pos = this->findEqualPosition(hint, val);
+
+    return this->linkNode(this->createNode(std::move(val)), pos.parent, pos.side);
+  }
+
+  template <class... Args>
+  base_ptr emplaceEqual(Args &&...args) {
+    pointer         z = this->createNode(std::forward<Args>(args)...);
+    insert_position pos = this->findEqualPosition(keyOf(z->data), false);
+
+    return this->linkNode(z, pos.parent, pos.side);
+  }
+
+  template <class... Args>
+  base_ptr emplaceHintEqual(base_ptr hint, Args &&...args) {
+    pointer         z = this->createNode(std::forward<Args>(args)...);
+    insert_position pos = this->findEqualPosition(hint, z->data);
+
+    return this->linkNode(z, pos.parent, pos.side);
+  }
+#endif
+
+  // range insertion : a sorted range going into an empty tree is built in O(n) (unique values for the unique trees),
+  // the other ranges are inserted value by value, each value hinted with the previous one (with the end for the equal trees)
+  template <class InputIterator>
+  void insertUniqueRange(InputIterator first, InputIterator last) {
+    this->insertRange(first, last, true, typename ft::iterator_traits<InputIterator>::iterator_category());
+  }
+
+  template <class InputIterator>
+  void insertEqualRange(InputIterator first, InputIterator last) {
+    this->insertRange(first, last, false, typename ft::iterator_traits<InputIterator>::iterator_category());
+  }
+
+  // a sorted random access range is built on the threads of the pool when the tree is empty, the other ranges
+  // go like insertUniqueRange
+  template <class InputIterator>
+  void insertUniqueRange(InputIterator first, InputIterator last, ft::thread_pool &pool) {
+    this->insertRange(first, last, pool, typename ft::iterator_traits<InputIterator>::iterator_category());
+  }
+
+  template <class InputIterator, class Tag>
+  void insertRange(InputIterator first, InputIterator last, ft::thread_pool &, Tag tag) {
+    this->insertRange(first, last, true, tag);
+  }
+  template <class RandomAccessIterator>
+  void insertRange(RandomAccessIterator first, RandomAccessIterator last, ft::thread_pool &pool, ft::random_access_iterator_tag) {
+    this->insertSortedRange(first, last, pool);
+  }
+  template <class RandomAccessIterator>
+  void insertRange(RandomAccessIterator first, RandomAccessIterator last, ft::thread_pool &pool, std::random_access_iterator_tag) {
+    this->insertSortedRange(first, last, pool);
+  }
+
+  template <class InputIterator>
+  void insertRange(InputIterator first, InputIterator last, bool unique, ft::input_iterator_tag) {
+    this->insertHintedRange(first, last, unique);
+  }
+  template <class InputIterator>
+  void insertRange(InputIterator first, InputIterator last, bool unique, std::input_iterator_tag) {
+    this->insertHintedRange(first, last, unique);
+  }
+
+  // forward iterators can be read twice : once to check the order, once to build
+  template <class ForwardIterator>
+  void insertRange(ForwardIterator first, ForwardIterator last, bool unique, ft::forward_iterator_tag) {
+    this->insertSortedRange(first, last, unique);
+  }
+  template <class ForwardIterator>
+  void insertRange(ForwardIterator first, ForwardIterator last, bool unique, std::forward_iterator_tag) {
+    this->insertSortedRange(first, last, unique);
+  }
+
+  template <class InputIterator>
+  void insertHintedRange(InputIterator first, InputIterator last, bool unique) {
+    base_ptr hint = this->endNode();
+
+    for (; first != last; ++first) {
+      if (unique)
+        hint = this->insertUnique(hint, *first).second;
+      else
+        this->insertEqual(this->endNode(), *first);
+    }
+  }
+
+  template <class ForwardIterator>
+  void insertSortedRange(ForwardIterator first, ForwardIterator last, bool unique) {
+    size_type n = this->empty() ? this->countSorted(first, last, unique) : 0;
+
+    if (n)
+      this->buildSorted(first, n);
+    else
+      this->insertHintedRange(first, last, unique);
+  }
+
+  template <class RandomAccessIterator>
+  void insertSortedRange(RandomAccessIterator first, RandomAccessIterator last, ft::thread_pool &pool) {
+    size_type n = this->empty() ? this->countSorted(first, last, true) : 0;
+
+    if (n)
+      this->buildSorted(first, n, pool);
+    else
+      this->insertHintedRange(first, last, true);
+  }
+
+  // size of the range when its values are increasing (strictly when `unique`), 0 otherwise
+  template <class ForwardIterator>
+  size_type countSorted(ForwardIterator first, ForwardIterator last, bool unique) const {
+    if (first == last) return 0;
+
+    size_type       n = 1;
+    ForwardIterator prev = first;
+    for (++first; first != last; prev = first, ++first, ++n)
+      if (unique ? !this->_comp(KeyOfValue()(*prev), KeyOfValue()(*first)) : this->_comp(KeyOfValue()(*first), KeyOfValue()(*prev))) return 0;
+    return n;
+  }
+
+  // build the empty tree from `n` sorted values : each subtree takes the middle value as root,
+  // so the tree is perfectly balanced, every node is black except the ones of the last level if it's incomplete.
+  // the nodes come in a single block when the allocator is a pool.
+  template <class ForwardIterator>
+  void buildSorted(ForwardIterator first, size_type n) {
+    pointer block = ft::allocate_bulk(this->_alloc, n);
+
+    this->setRoot(makeSubtree(this->buildSubtree(first, block, n, 0, redDepth(n)), 0), n);
+  }
+
+  // the same tree, the subtrees of at least the grain of the pool are built by two tasks (the nodes are constructed
+  // in place in the block, the allocator isn't used). sequential when the nodes don't come in a block
+  template <class RandomAccessIterator>
+  void buildSorted(RandomAccessIterator first, size_type n, ft::thread_pool &pool) {
+    pointer block = ft::allocate_bulk(this->_alloc, n);
+
+    if (block)
+      this->setRoot(makeSubtree(this->buildParallel(first, block, n, 0, redDepth(n), pool), 0), n);
+    else
+      this->setRoot(makeSubtree(this->buildSubtree(first, block, n, 0, redDepth(n)), 0), n);
+  }
+
+  // the depth of the red nodes in a perfectly balanced tree of n nodes : floor(log2(n + 1))
+  static size_type redDepth(size_type n) {
+    size_type depth = 0;
+
+    while ((size_type(2) << depth) <= n + 1) depth++;
+    return depth;
+  }
+
+  template <class ForwardIterator>
+  base_ptr buildSubtree(ForwardIterator &first, pointer &block, size_type n, size_type depth, size_type red_depth) {
+    if (!n) return nullptr;
+
+    size_type left_size = (n - 1) / 2;
+    base_ptr  left = this->buildSubtree(first, block, left_size, depth + 1, red_depth);
+    base_ptr  z = this->constructNode(block ? block++ : this->_alloc.allocate(1), *first);
+
+    ++first;
+    z->left = left;
+    z->right = this->buildSubtree(first, block, n - 1 - left_size, depth + 1, red_depth);
+    z->setColor(depth == red_depth ? red : black);
+    if (z->left) z->left->setParent(z);
+    if (z->right) z->right->setParent(z);
+    this->pull(z);
+    return z;
+  }
+
+  template <class RandomAccessIterator>
+  struct build_task : public ft::thread_pool::task {
+    RedBlackTree        *tree;
+    RandomAccessIterator first;
+    pointer              block;
+    size_type            n;
+    size_type            depth;
+    size_type            red_depth;
+    ft::thread_pool     *pool;
+    base_ptr             root;
+
+    build_task(RedBlackTree *t, RandomAccessIterator from, pointer nodes, size_type count, size_type level, size_type red_level, ft::thread_pool *threads)
+        : task(run), tree(t), first(from), block(nodes), n(count), depth(level), red_depth(red_level), pool(threads), root(nullptr) {}
+
+    static void run(ft::thread_pool::task *t) {
+      build_task *b = static_cast<build_task *>(t);
+      b->root = b->tree->buildParallel(b->first, b->block, b->n, b->depth, b->red_depth, *b->pool);
     }
+  };
 
-    if (z->parent == nullptr) {
-      z->color = black;
-    } else if (z->parent->parent != nullptr) {
-      this->insertFixUp(z);
+  // the left subtree goes to a task while this thread builds the right one, the middle value is at the same index
+  // in the range & in the block
+  template <class RandomAccessIterator>
+  base_ptr buildParallel(RandomAccessIterator first, pointer block, size_type n, size_type depth, size_type red_depth, ft::thread_pool &pool) {
+    if (n < pool.grain() || pool.size() == 1) return this->buildSubtree(first, block, n, depth, red_depth);
+
+    size_type                        left_size = (n - 1) / 2;
+    build_task<RandomAccessIterator> left(this, first, block, left_size, depth + 1, red_depth, &pool);
+    base_ptr                         right;
+
+    pool.fork(left);
+    try {
+      right = this->buildParallel(first + (left_size + 1), block + (left_size + 1), n - 1 - left_size, depth + 1, red_depth, pool);
+    } catch (...) {
+      pool.join(left);  // the task is on this stack
+      throw;
     }
+    pool.join(left);
+    return this->linkChildren(this->constructNode(block + left_size, first[left_size]), left.root, right, depth == red_depth ? red : black);
+  }
+
+  // link the allocated node `z` as the `side` child of `parent` (the root when parent is null) & rebalance it
+  base_ptr linkNode(base_ptr z, base_ptr parent, short side) {
+    z->left = nullptr;
+    z->right = nullptr;
+    z->setColor(red);
+    if (parent == nullptr) {
+      z->setParent(&this->_header);
+      this->_header.setParent(z);
+      this->_header.left = z;
+      this->_header.right = z;
+    } else {
+      z->setParent(parent);
+      if (side == LEFT_SIDE) {
+        parent->left = z;
+        if (parent == this->_header.left) this->_header.left = z;
+      } else {
+        parent->right = z;
+        if (parent == this->_header.right) this->_header.right = z;
+      }
+    }
+    this->pullPath(z);
+    this->insertFixUp(z);
     this->_size++;
-    this->set_end();
     return z;
   }
 
@@ -345,27 +752,29 @@ class RedBlackTree {
   // Left-Rotate gP.
   // Set the root of the tree as BLACK.
 
-  void insertFixUp(pointer x) {
-    pointer w;
-    while (x != this->_root && x->parent->isRed()) {
-      short side = x->getParent()->isRightChild() ? RIGHT_SIDE : LEFT_SIDE;
-      w = x->getUncle();
-      if (w->isRed()) {
+  // (a red parent is never the root, so the grandparent is a node & not the header)
+  void insertFixUp(base_ptr x) {
+    base_ptr w;
+    while (x != this->getRoot() && x->getParent()->isRed()) {
+      base_ptr grand_parent = x->getParent()->getParent();
+      short    side = x->getParent() == grand_parent->right ? RIGHT_SIDE : LEFT_SIDE;
+      w = grand_parent->getSide(!side);  // the uncle
+      if (base_type::isRed(w)) {
         // case 1 : uncle is red
         // set w to black
         // recolor x parent to black
         // recolor x grandparent to red
         // set x to x grandparent
-        w->color = black;
-        x->parent->color = black;
-        x->getGrandParent()->color = red;
-        x = x->getGrandParent();
+        w->setColor(black);
+        x->getParent()->setColor(black);
+        grand_parent->setColor(red);
+        x = grand_parent;
       } else {
-        if (x == x->parent->getSide(!side)) {
+        if (x == x->getParent()->getSide(!side)) {
           // case 2 : uncle is black and x is on the other side of its parent
           // set x to x parent
           // rotate x to the same side as x parent
-          x = x->parent;
+          x = x->getParent();
           this->rotate(x, side);
         }
 
@@ -373,71 +782,109 @@ class RedBlackTree {
         // recolor x parent to black
         // recolor x grandparent to red
         // rotate x grandparent to the other side
-        x->parent->color = black;
-        x->getGrandParent()->color = red;
-        this->rotate(x->getGrandParent(), !side);
+        x->getParent()->setColor(black);
+        grand_parent->setColor(red);
+        this->rotate(grand_parent, !side);
       }
     }
-    this->_root->color = black;
+    this->getRoot()->setColor(black);
   }
 
-  void transplant(pointer u, pointer v) {
-    if (u->parent == nullptr) {
-      this->_root = v;
-    } else if (u->isLeftChild()) {
-      u->parent->left = v;
+  // put `v` (maybe a leaf) in the place of `u` under the parent of `u`
+  void transplant(base_ptr u, base_ptr v) {
+    if (u == this->getRoot()) {
+      this->_header.setParent(v);
+    } else if (u == u->getParent()->left) {
+      u->getParent()->left = v;
     } else {
-      u->parent->right = v;
+      u->getParent()->right = v;
     }
-    v->parent = u->parent;
+    if (v) v->setParent(u->getParent());
   }
 
-  bool deleteNode(const value_type &val) {
-    pointer z = this->find(val);
-    if (z->isNil()) return false;
+  bool deleteNode(const key_type &k) {
+    iterator it = this->find(k);
+    if (it == this->end()) return false;
 
-    this->unset_end();
-    pointer y = z;
+    this->eraseNode(it.base());
+    return true;
+  }
 
-    pointer x = nullptr;
+  // erase all the values of the key `k`, O(log n + their number)
+  size_type deleteEqual(const key_type &k) {
+    ft::pair<iterator, iterator> range = this->equalRange(k);
 
-    bool original_color = y->color;
+    return this->eraseRange(range.first.base(), range.second.base());
+  }
+
+  // erase [first, last) walking from node to node (no search), the whole tree is cleared at once.
+  // returns the number of erased values
+  size_type eraseRange(base_ptr first, base_ptr last) {
+    size_type n = this->size();
+
+    if (first == this->_header.left && last == this->endNode()) {
+      this->clear();
+      return n;
+    }
+    while (first != last) {
+      base_ptr next = base_type::getSuccessor(first);
+
+      this->eraseNode(first);
+      first = next;
+    }
+    return n - this->size();
+  }
+
+  // unlink the node `z` from the tree & destroy it, the other nodes don't move
+  void eraseNode(base_ptr z) {
+    this->unlinkNode(z);
+    this->destroyNode(z);
+  }
 
-    if (z->left->isNil())  // start of case 1
+  // unlink the node `z` from the tree & rebalance it, `z` itself is left as it is.
+  // x takes the place of the unlinked node, it may be a leaf so its parent is tracked on the side.
+  void unlinkNode(base_ptr z) {
+    if (z == this->_header.left) this->_header.left = z->right ? base_type::getMinimum(z->right) : z->getParent();
+    if (z == this->_header.right) this->_header.right = z->left ? base_type::getMaximum(z->left) : z->getParent();
+    base_ptr y = z;
+    base_ptr x = nullptr;
+    base_ptr x_parent = z->getParent();
+
+    bool original_color = y->getColor();
+
+    if (!z->left)  // start of case 1
     {
       x = z->right;
       this->transplant(z, x);
-    }                            // end of case 1
-    else if (z->right->isNil())  // start of case 2
+    }                   // end of case 1
+    else if (!z->right)  // start of case 2
     {
       x = z->left;
       this->transplant(z, x);
     }     // end of case 2
     else  // start of case 3
     {
-      y = node_type::getMinimum(z->right);
-      original_color = y->color;
+      y = base_type::getMinimum(z->right);
+      original_color = y->getColor();
       x = y->right;
 
       if (y->getParent() == z)
-        x->parent = y;
+        x_parent = y;
       else {
+        x_parent = y->getParent();
         this->transplant(y, y->right);
         y->right = z->right;
-        y->right->parent = y;
+        y->right->setParent(y);
       }
       this->transplant(z, y);
       y->left = z->left;
-      y->left->parent = y;
-      y->color = z->color;
+      y->left->setParent(y);
+      y->setColor(z->getColor());
     }  // end of case 3
 
-    this->_alloc.destroy(z);
-    this->_alloc.deallocate(z, 1);
     this->_size--;
-    if (original_color == black) this->deleteFixUp(x);
-    this->set_end();
-    return true;
+    this->pullPath(x_parent);
+    if (original_color == black) this->deleteFixUp(x, x_parent);
   }
 
   // This algorithm is implemented when a black node is deleted because it violates the black depth property of the red-black tree.
@@ -483,149 +930,833 @@ class RedBlackTree {
   // Else the same as above with right changed to left and vice versa.
   // Set the color of x as BLACK.
 
-  void deleteFixUp(pointer x) {
-    pointer w;
-    while (x != this->_root && x->color == black) {
-      short side = x->isLeftChild() ? LEFT_SIDE : RIGHT_SIDE;
-      w = x->getSibling();
-      if (w->color == red) {  // case 1
-        w->color = black;
-        x->parent->color = red;
-        this->rotate(x->parent, side);
-        w = x->getSibling();  // end of case 1
+  // (x is null when it's a leaf, its sibling w is then a node : the erased black node left a black height of at least 1 there)
+  void deleteFixUp(base_ptr x, base_ptr x_parent) {
+    base_ptr w;
+    while (x != this->getRoot() && base_type::isBlack(x)) {
+      short side = x == x_parent->left ? LEFT_SIDE : RIGHT_SIDE;
+      w = x_parent->getSide(!side);
+      if (w->getColor() == red) {  // case 1
+        w->setColor(black);
+        x_parent->setColor(red);
+        this->rotate(x_parent, side);
+        w = x_parent->getSide(!side);  // end of case 1
       }
 
-      if (w->left->color == black && w->right->color == black) {  // case 2
-        w->color = red;
-        x = x->getParent();  // end of case 2
+      if (base_type::isBlack(w->left) && base_type::isBlack(w->right)) {  // case 2
+        w->setColor(red);
+        x = x_parent;
+        x_parent = x_parent->getParent();  // end of case 2
       } else {
-        if (w->getSide(!side)->color == black) {  // case 3
-          w->getSide(side)->color = black;
-          w->color = red;
+        if (base_type::isBlack(w->getSide(!side))) {  // case 3
+          w->getSide(side)->setColor(black);
+          w->setColor(red);
           this->rotate(w, !side);
-          w = x->getSibling();
+          w = x_parent->getSide(!side);
         }
-        w->color = x->parent->color;  // case 4
-        x->parent->color = black;
-        if (side == LEFT_SIDE)
-          w->right->color = black;
-        else
-          w->left->color = black;
-        this->rotate(x->parent, side);
-        x = this->_root;  // end of case 4
+        w->setColor(x_parent->getColor());  // case 4
+        x_parent->setColor(black);
+        w->getSide(!side)->setColor(black);
+        this->rotate(x_parent, side);
+        x = this->getRoot();  // end of case 4
+      }
+    }
+    if (x) x->setColor(black);
+  }
+
+  // node handles (see node_handle.hpp) : extract unlinks a node & hands it over with a copy of the allocator, the
+  // insertions link it as it is. the pool of the handle joins the pool of the tree first, so the tree can give the node
+  // back later : no allocation & no copy of the value (unless the allocators can't share their nodes, the value is then
+  // copied to a node of this tree & the node of the handle destroyed)
+  template <class Handle>
+  Handle extractNode(base_ptr z) {
+    this->unlinkNode(z);
+    return Handle(static_cast<pointer>(z), this->_alloc);
+  }
+
+  // the node of the handle goes in when its key isn't here (the handle is emptied), or the node of the key stays
+  template <class Handle>
+  ft::pair<bool, base_ptr> insertUniqueNode(Handle &nh) {
+    if (nh.empty()) return ft::make_pair(false, this->endNode());
+
+    insert_position pos = this->findUniquePosition(nh._node->data);
+    if (pos.exists) return ft::make_pair(false, pos.parent);
+    return ft::make_pair(true, this->linkNode(this->adoptNode(nh), pos.parent, pos.side));
+  }
+
+  template <class Handle>
+  pointer adoptNode(Handle &nh) {
+    pointer z = nh._node;
+
+    if (ft::join_pool(this->_alloc, nh._alloc))
+      nh._node = nullptr;
+    else {
+      z = this->createNode(FT_MOVE(z->data));
+      nh.reset();
+    }
+    return z;
+  }
+
+  // the augmented policies keep a summary of each subtree in its root (see node_policy.hpp) : the summary of a node
+  // is recomputed when its children change, the rotations keep the summaries above them. no-ops for the other policies.
+  void pull(base_ptr x) {
+    if (NodePolicy::augmented) x->pull(node_type::valueOf(x));
+  }
+
+  // the summaries of x & of all its ancestors
+  void pullPath(base_ptr x) {
+    if (NodePolicy::augmented)
+      for (; x != this->endNode(); x = x->getParent()) this->pull(x);
+  }
+
+  // order statistics, only with a policy counting the nodes of the subtrees (ft::counted_node)
+
+  static size_type countOf(base_ptr x) { return x ? x->count : 0; }
+
+  // the node at the position `k` (0 based) of the in-order sequence, or the end
+  iterator nth(size_type k) const {
+    base_ptr x = this->getRoot();
+
+    while (x) {
+      size_type left = countOf(x->left);
+
+      if (k < left)
+        x = x->left;
+      else if (k == left)
+        return iterator(x);
+      else {
+        k -= left + 1;
+        x = x->right;
       }
     }
-    x->color = black;
+    return this->end();
+  }
+
+  // the number of keys less than `k`
+  template <class K>
+  size_type rank(const K &k) const {
+    base_ptr  x = this->getRoot();
+    size_type r = 0;
+
+    while (x) {
+      if (this->_comp(keyOf(x), k)) {
+        r += countOf(x->left) + 1;
+        x = x->right;
+      } else
+        x = x->left;
+    }
+    return r;
+  }
+
+  // the position of a node in the in-order sequence, size() for the end : climbing from a right child passes
+  // its parent & the left subtree of its parent
+  size_type position(base_ptr x) const {
+    if (x == this->endNode()) return this->size();
+
+    size_type r = countOf(x->left);
+    for (; x != this->getRoot(); x = x->getParent())
+      if (x == x->getParent()->right) r += countOf(x->getParent()->left) + 1;
+    return r;
+  }
+
+  difference_type distance(base_ptr first, base_ptr last) const { return difference_type(this->position(last)) - difference_type(this->position(first)); }
+
+  // range aggregates, only with a policy summarizing the subtrees by a monoid (ft::augmented_node)
+
+  static summary_type summaryOf(base_ptr x) { return x ? x->summary : monoid_type::identity(); }
+
+  // the combination, in order, of the values whose key is in [lo, hi) : the descent stops on the first node in the range,
+  // from there a path goes down to lo & another one down to hi, taking the summaries of the subtrees in between
+  template <class K>
+  summary_type aggregate(const K &lo, const K &hi) const {
+    base_ptr x = this->getRoot();
+
+    while (x && (this->_comp(keyOf(x), lo) || !this->_comp(keyOf(x), hi))) x = this->_comp(keyOf(x), lo) ? x->right : x->left;
+    if (!x) return monoid_type::identity();
+
+    summary_type left = monoid_type::identity();
+    for (base_ptr y = x->left; y;) {
+      if (this->_comp(keyOf(y), lo))
+        y = y->right;
+      else {
+        left = monoid_type::combine(monoid_type::combine(monoid_type::of(node_type::valueOf(y)), summaryOf(y->right)), left);
+        y = y->left;
+      }
+    }
+    summary_type right = monoid_type::identity();
+    for (base_ptr y = x->right; y;) {
+      if (this->_comp(keyOf(y), hi)) {
+        right = monoid_type::combine(right, monoid_type::combine(summaryOf(y->left), monoid_type::of(node_type::valueOf(y))));
+        y = y->right;
+      } else
+        y = y->left;
+    }
+    return monoid_type::combine(monoid_type::combine(left, monoid_type::of(node_type::valueOf(x))), right);
+  }
+
+  // set algebra by splitting & joining subtrees (see "Just Join for Parallel Ordered Sets", Blelloch, Ferizovic & Sun) :
+  // the union, the intersection & the difference of trees of m <= n nodes take O(m log(n/m + 1)), no value is copied.
+  // the subtrees are detached from the tree while they're cut & glued, the parent of their root isn't used.
+  // a subtree comes with its black height : the number of black nodes on a path from its root down to a leaf.
+
+  struct subtree {
+    base_ptr  root;
+    size_type height;
+  };
+
+  // nodes linked in order through their right pointer
+  struct node_list {
+    base_ptr  head;
+    base_ptr  tail;
+    size_type size;
+
+    void push(base_ptr x) {
+      x->right = nullptr;
+      if (this->tail)
+        this->tail->right = x;
+      else
+        this->head = x;
+      this->tail = x;
+      this->size++;
+    }
+
+    void append(const node_list &other) {
+      if (!other.head) return;
+      if (this->tail)
+        this->tail->right = other.head;
+      else
+        this->head = other.head;
+      this->tail = other.tail;
+      this->size += other.size;
+    }
+  };
+
+  static subtree makeSubtree(base_ptr root, size_type height) {
+    subtree t = {root, height};
+    return t;
   }
 
-  // find
-  pointer find(const value_type &val) const { return node_type::template find<Compare>(this->_root, val, this->_comp); }
+  subtree rootSubtree(void) const {
+    size_type height = 0;
 
-  pointer getMinimum(void) const { return node_type::getMinimum(this->_root); }
+    for (base_ptr x = this->getRoot(); x; x = x->left) height += x->isBlack();
+    return makeSubtree(this->getRoot(), height);
+  }
 
-  pointer getMaximum(void) const { return node_type::getMaximum(this->_root); }
+  // hang the subtree under the header, the tree holds its `n` nodes
+  void setRoot(subtree t, size_type n) {
+    this->_header.setParent(t.root);
+    if (t.root) {
+      t.root->setParent(&this->_header);
+      t.root->setColor(black);
+    }
+    this->_size = n;
+    this->updateExtremes();
+  }
 
-  void rotate(pointer node, short side) {
+  static void setChild(base_ptr x, short side, base_ptr child) {
     if (side == LEFT_SIDE)
-      this->leftRotate(node);
+      x->left = child;
     else
-      this->rightRotate(node);
+      x->right = child;
+    if (child) child->setParent(x);
   }
 
-  void leftRotate(pointer x) {
-    pointer y = x->right;
-    x->right = y->left;
-    if (y->left != this->_nil) {
-      y->left->parent = x;
-    }
-    y->parent = x->parent;
-    if (x->parent == nullptr) {
-      this->_root = y;
-    } else if (x->isLeftChild()) {
-      x->parent->left = y;
-    } else {
-      x->parent->right = y;
+  base_ptr linkChildren(base_ptr k, base_ptr left, base_ptr right, bool color) {
+    setChild(k, LEFT_SIDE, left);
+    setChild(k, RIGHT_SIDE, right);
+    k->setColor(color);
+    this->pull(k);
+    return k;
+  }
+
+  // the `side` child of x takes the place of x, which becomes its other child
+  base_ptr rotateUp(base_ptr x, short side) {
+    base_ptr y = x->getSide(side);
+
+    setChild(x, side, y->getSide(!side));
+    setChild(y, !side, x);
+    this->pull(x);
+    this->pull(y);
+    return y;
+  }
+
+  // the subtree l, then k, then the subtree r (every key of l is less than k, every key of r is greater) :
+  // k goes down the spine of the higher subtree until the black heights match, O(difference of the heights)
+  subtree join(subtree l, base_ptr k, subtree r) {
+    if (base_type::isRed(l.root)) {
+      l.root->setColor(black);
+      l.height++;
     }
-    y->left = x;
-    x->parent = y;
+    if (base_type::isRed(r.root)) {
+      r.root->setColor(black);
+      r.height++;
+    }
+    if (l.height == r.height) return makeSubtree(this->linkChildren(k, l.root, r.root, red), l.height);
+    if (l.height > r.height) return makeSubtree(this->joinSpine(l.root, l.height, k, r.root, r.height, RIGHT_SIDE), l.height);
+    return makeSubtree(this->joinSpine(r.root, r.height, k, l.root, l.height, LEFT_SIDE), r.height);
   }
 
-  void rightRotate(pointer x) {
-    pointer y = x->left;
-    x->left = y->right;
-    if (y->right != this->_nil) {
-      y->right->parent = x;
-    }
-    y->parent = x->parent;
-    if (x->parent == nullptr) {
-      this->_root = y;
-    } else if (x->isRightChild()) {
-      x->parent->right = y;
+  // k & the lower subtree `low` are linked on the `side` spine of x, the red-red links are rotated away on the way up
+  base_ptr joinSpine(base_ptr x, size_type height, base_ptr k, base_ptr low, size_type low_height, short side) {
+    if (base_type::isBlack(x) && height == low_height)
+      return side == RIGHT_SIDE ? this->linkChildren(k, x, low, red) : this->linkChildren(k, low, x, red);
+
+    base_ptr y = this->joinSpine(x->getSide(side), height - x->isBlack(), k, low, low_height, side);
+
+    setChild(x, side, y);
+    if (x->isBlack() && y->isRed() && base_type::isRed(y->getSide(side))) {
+      y->getSide(side)->setColor(black);
+      return this->rotateUp(x, side);
+    }
+    this->pull(x);
+    return x;
+  }
+
+  // the subtree l, then the subtree r, the last node of l joins them
+  subtree join(subtree l, subtree r) {
+    if (!l.root) return r;
+    if (!r.root) return l;
+
+    base_ptr last;
+    subtree  rest = this->splitLast(l, last);
+    return this->join(rest, last, r);
+  }
+
+  subtree splitLast(subtree t, base_ptr &last) {
+    base_ptr x = t.root;
+    subtree  left = makeSubtree(x->left, t.height - x->isBlack());
+
+    if (!x->right) {
+      last = x;
+      return left;
+    }
+    subtree rest = this->splitLast(makeSubtree(x->right, left.height), last);
+    return this->join(left, x, rest);
+  }
+
+  // cut the subtree around the key `k` : the keys less than k, the node of k (null if it's not there) & the greater keys
+  void split(subtree t, const key_type &k, subtree &less, base_ptr &found, subtree &greater) {
+    base_ptr x = t.root;
+
+    if (!x) {
+      less = greater = t;
+      found = nullptr;
+      return;
+    }
+    subtree left = makeSubtree(x->left, t.height - x->isBlack());
+    subtree right = makeSubtree(x->right, left.height);
+    if (this->_comp(k, keyOf(x))) {
+      this->split(left, k, less, found, greater);
+      greater = this->join(greater, x, right);
+    } else if (this->_comp(keyOf(x), k)) {
+      this->split(right, k, less, found, greater);
+      less = this->join(left, x, less);
     } else {
-      x->parent->left = y;
+      less = left;
+      greater = right;
+      found = x;
     }
-    y->right = x;
-    x->parent = y;
   }
 
-  iterator lower_bound(const value_type &k) {
-    pointer node = this->_root;
+  // the nodes of both subtrees, on equal keys the node of a stays & the one of b goes to `dropped`
+  subtree unite(subtree a, subtree b, node_list &dropped) {
+    if (!a.root) return b;
+    if (!b.root) return a;
+
+    base_ptr k = b.root;
+    subtree  b_left = makeSubtree(k->left, b.height - k->isBlack());
+    subtree  b_right = makeSubtree(k->right, b_left.height);
+    subtree  a_left, a_right;
+    base_ptr found;
+
+    this->split(a, keyOf(k), a_left, found, a_right);
+    subtree left = this->unite(a_left, b_left, dropped);
+    if (found) {
+      dropped.push(k);
+      k = found;
+    }
+    return this->join(left, k, this->unite(a_right, b_right, dropped));
+  }
 
-    iterator iter = this->end();
+  // the nodes of a whose key is in the (untouched) subtree b, the other ones are destroyed (listed in `dropped` if any)
+  subtree intersect(subtree a, base_ptr b, size_type &kept, node_list *dropped) {
+    if (!a.root) return a;
+    if (!b) {
+      if (dropped)
+        listSubtree(a.root, *dropped);
+      else
+        this->destroySubtree(a.root, true);
+      return makeSubtree(nullptr, 0);
+    }
 
-    while (!node->isNil()) {
-      if (!this->_comp(node->data, k)) {
-        iter = iterator(node);
-        node = node->left;
-      } else
-        node = node->right;
+    subtree  a_left, a_right;
+    base_ptr found;
+
+    this->split(a, keyOf(b), a_left, found, a_right);
+    subtree left = this->intersect(a_left, b->left, kept, dropped);
+    subtree right = this->intersect(a_right, b->right, kept, dropped);
+    if (!found) return this->join(left, right);
+    kept++;
+    return this->join(left, found, right);
+  }
+
+  // the nodes of a whose key isn't in the (untouched) subtree b, the other ones are destroyed (listed in `dropped` if any)
+  subtree subtract(subtree a, base_ptr b, size_type &erased, node_list *dropped) {
+    if (!a.root || !b) return a;
+
+    subtree  a_left, a_right;
+    base_ptr found;
+
+    this->split(a, keyOf(b), a_left, found, a_right);
+    subtree left = this->subtract(a_left, b->left, erased, dropped);
+    subtree right = this->subtract(a_right, b->right, erased, dropped);
+    if (found) {
+      if (dropped)
+        dropped->push(found);
+      else
+        this->destroyNode(found);
+      erased++;
     }
-    return iterator(iter);
+    return this->join(left, right);
   }
-  const_iterator lower_bound(const value_type &k) const {
-    pointer node = this->_root;
 
-    iterator iter = this->end();
+  // the nodes of the subtree in order, taken apart like in destroySubtree
+  static void listSubtree(base_ptr x, node_list &list) {
+    while (x) {
+      base_ptr y = x->left;
 
-    while (!node->isNil()) {
-      if (!this->_comp(node->data, k)) {
-        iter = iterator(node);
-        node = node->left;
-      } else
-        node = node->right;
+      if (y) {
+        x->left = y->right;
+        y->right = x;
+      } else {
+        y = x->right;
+        list.push(x);
+      }
+      x = y;
+    }
+  }
+
+  void destroyList(base_ptr list) {
+    while (list) {
+      base_ptr next = list->right;
+      this->destroyNode(list);
+      list = next;
+    }
+  }
+
+  // the parallel set algebra : the two sides of a split are independent, the lower one goes to a task while this
+  // thread takes the upper one, down to operands under the grain of the pool (by their black height, a subtree of
+  // black height h has 2^h - 1 nodes at least). the tasks only relink nodes & call the comparator : the nodes to
+  // destroy are listed, the caller destroys them once the tasks are over (the allocator isn't shared).
+  enum algebra_op { UNITE, INTERSECT, SUBTRACT };
+
+  struct algebra_task : public ft::thread_pool::task {
+    RedBlackTree    *tree;
+    ft::thread_pool *pool;
+    algebra_op       op;
+    subtree          a;
+    subtree          b;
+    subtree          result;
+    node_list        dropped;  // the nodes of b whose key is in a for a union, the destroyed nodes of a otherwise
+    size_type        count;    // the kept nodes of a for an intersection, the erased ones for a difference
+
+    algebra_task(RedBlackTree *t, ft::thread_pool *p, algebra_op o, subtree lhs, subtree rhs) : task(run), tree(t), pool(p), op(o), a(lhs), b(rhs), count(0) {
+      this->result = makeSubtree(nullptr, 0);
+      this->dropped.head = this->dropped.tail = nullptr;
+      this->dropped.size = 0;
+    }
+
+    static void run(ft::thread_pool::task *t) {
+      algebra_task *job = static_cast<algebra_task *>(t);
+      job->tree->algebra(*job);
+    }
+  };
+
+  void algebra(algebra_task &t) {
+    size_type height = t.a.height < t.b.height ? t.a.height : t.b.height;
+
+    if (!t.a.root || !t.b.root || t.pool->size() == 1 || (size_type(1) << height) - 1 < t.pool->grain()) {
+      if (t.op == UNITE)
+        t.result = this->unite(t.a, t.b, t.dropped);
+      else if (t.op == INTERSECT)
+        t.result = this->intersect(t.a, t.b.root, t.count, &t.dropped);
+      else
+        t.result = this->subtract(t.a, t.b.root, t.count, &t.dropped);
+      return;
+    }
+
+    base_ptr k = t.b.root;
+    subtree  b_left = makeSubtree(k->left, t.b.height - k->isBlack());
+    subtree  b_right = makeSubtree(k->right, b_left.height);
+    subtree  a_left, a_right;
+    base_ptr found;
+
+    this->split(t.a, keyOf(k), a_left, found, a_right);
+    algebra_task left(this, t.pool, t.op, a_left, b_left);
+    algebra_task right(this, t.pool, t.op, a_right, b_right);
+
+    t.pool->fork(left);
+    try {
+      this->algebra(right);
+    } catch (...) {
+      t.pool->join(left);  // the task is on this stack
+      throw;
+    }
+    t.pool->join(left);
+    t.count = left.count + right.count;
+    t.dropped = left.dropped;
+    if (t.op == UNITE && found) {
+      t.dropped.push(k);
+      k = found;
+    } else if (t.op == INTERSECT && found) {
+      t.count++;
+      k = found;
+    } else if (t.op == SUBTRACT && found) {
+      t.dropped.push(found);
+      t.count++;
+    }
+    t.dropped.append(right.dropped);
+    if (t.op == UNITE || (t.op == INTERSECT && found))
+      t.result = this->join(left.result, k, right.result);
+    else
+      t.result = this->join(left.result, right.result);
+  }
+
+  // below that size ratio, cutting the large tree costs more than a descent for each node of the small one
+  static const size_type small_operand_ratio = 32;
+
+  bool smallOperand(size_type n) const { return n * small_operand_ratio < this->_size; }
+
+  // the nodes of x join this tree, except the ones of keys already here : they're listed in `dropped`.
+  // false when the allocators can't share the nodes, nothing moved then
+  bool absorb(RedBlackTree &x, node_list &dropped, ft::thread_pool *pool) {
+    if (!ft::join_pool(this->_alloc, x._alloc)) return false;
+
+    if (this->smallOperand(x._size)) {
+      base_ptr y = x.getRoot();
+
+      x.resetHeader();
+      x._size = 0;
+      // x is taken apart in order, like in destroySubtree
+      while (y) {
+        base_ptr z = y->left;
+
+        if (z) {
+          y->left = z->right;
+          z->right = y;
+        } else {
+          z = y->right;
+          insert_position pos = this->findUniquePosition(node_type::valueOf(y));
+          if (pos.exists)
+            dropped.push(y);
+          else
+            this->linkNode(y, pos.parent, pos.side);
+        }
+        y = z;
+      }
+      return true;
+    }
+    size_type n = this->_size + x._size;
+    subtree   t;
+
+    if (pool) {
+      algebra_task job(this, pool, UNITE, this->rootSubtree(), x.rootSubtree());
+      this->algebra(job);
+      t = job.result;
+      dropped = job.dropped;
+    } else
+      t = this->unite(this->rootSubtree(), x.rootSubtree(), dropped);
+    x.resetHeader();
+    x._size = 0;
+    this->setRoot(t, n - dropped.size);
+    return true;
+  }
+
+  // the union in this tree, x is left empty : on equal keys the value of this tree stays & the one of x is destroyed.
+  // the operations given a pool run on its threads
+  void unionWith(RedBlackTree &x, ft::thread_pool *pool = nullptr) {
+    node_list dropped = {nullptr, nullptr, 0};
+
+    if (this == &x || x.empty()) return;
+    if (this->absorb(x, dropped, pool)) return this->destroyList(dropped.head);
+    // the values are copied when the nodes can't move
+    for (base_ptr hint = this->endNode(), y = x._header.left; y != x.endNode(); y = base_type::getSuccessor(y))
+      hint = this->insertUnique(hint, node_type::valueOf(y)).second;
+    x.clear();
+  }
+
+  // the nodes of x whose key isn't in this tree move here, the other ones stay in x
+  void merge(RedBlackTree &x, ft::thread_pool *pool = nullptr) {
+    node_list dropped = {nullptr, nullptr, 0};
+
+    if (this == &x || x.empty()) return;
+    if (this->absorb(x, dropped, pool)) {
+      x.buildFromList(dropped.head, dropped.size);
+      return;
+    }
+    for (base_ptr y = x._header.left; y != x.endNode();) {
+      base_ptr next = base_type::getSuccessor(y);
+
+      if (this->insertUnique(node_type::valueOf(y)).first) x.eraseNode(y);
+      y = next;
+    }
+  }
+
+  // the intersection in this tree, x doesn't change
+  void intersectWith(const RedBlackTree &x, ft::thread_pool *pool = nullptr) {
+    size_type kept = 0;
+
+    if (this == &x) return;
+    if (pool) {
+      algebra_task job(this, pool, INTERSECT, this->rootSubtree(), x.rootSubtree());
+      this->algebra(job);
+      this->setRoot(job.result, job.count);
+      return this->destroyList(job.dropped.head);
+    }
+    subtree t = this->intersect(this->rootSubtree(), x.getRoot(), kept, nullptr);
+    this->setRoot(t, kept);
+  }
+
+  // the difference in this tree, x doesn't change
+  void subtract(const RedBlackTree &x, ft::thread_pool *pool = nullptr) {
+    size_type erased = 0;
+
+    if (this == &x) return this->clear();
+    if (this->smallOperand(x._size)) {
+      for (base_ptr y = x._header.left; y != x.endNode(); y = base_type::getSuccessor(y)) this->deleteNode(keyOf(y));
+      return;
+    }
+    if (pool) {
+      algebra_task job(this, pool, SUBTRACT, this->rootSubtree(), x.rootSubtree());
+      this->algebra(job);
+      this->setRoot(job.result, this->_size - job.count);
+      return this->destroyList(job.dropped.head);
+    }
+    subtree t = this->subtract(this->rootSubtree(), x.getRoot(), erased, nullptr);
+    this->setRoot(t, this->_size - erased);
+  }
+
+  // the empty tree takes the `n` nodes of the sorted list, balanced like a bulk build
+  void buildFromList(base_ptr list, size_type n) {
+    this->setRoot(makeSubtree(this->linkList(list, n, 0, redDepth(n)), 0), n);
+  }
+
+  base_ptr linkList(base_ptr &list, size_type n, size_type depth, size_type red_depth) {
+    if (!n) return nullptr;
+
+    size_type left_size = (n - 1) / 2;
+    base_ptr  left = this->linkList(list, left_size, depth + 1, red_depth);
+    base_ptr  z = list;
+
+    list = list->right;
+    return this->linkChildren(z, left, this->linkList(list, n - 1 - left_size, depth + 1, red_depth), depth == red_depth ? red : black);
+  }
+
+  // key of a value or of a node
+  static const key_type &keyOf(const value_type &val) { return KeyOfValue()(val); }
+  static const key_type &keyOf(base_ptr x) { return KeyOfValue()(node_type::valueOf(x)); }
+
+  // the lookups compare the keys directly, they are templates so a transparent comparator
+  // can compare them with another type (the map & the set only expose that when it is).
+
+  // the node of the key `k`, or the end
+  template <class K>
+  iterator find(const K &k) const {
+    base_ptr x = this->getRoot();
+
+    while (x) {
+      if (this->_comp(k, keyOf(x)))
+        x = x->left;
+      else if (this->_comp(keyOf(x), k))
+        x = x->right;
+      else
+        return iterator(x);
+    }
+    return this->end();
+  }
+
+  // the number of descents findMany interleaves : enough misses in flight to hide the memory latency,
+  // few enough to keep their state in registers
+  static const size_type batch_lanes = 8;
+
+  // the node of each key of [first, last) (or the end) written to `out` in the order of the keys. the descents of
+  // batch_lanes keys go one level at a time, each step prefetches the next node of its key : while a node is on its
+  // way from memory, the other descents compare. on a tree larger than the caches most levels are misses, a loop of
+  // find waits for each one in turn
+  template <class ForwardIterator, class OutputIterator>
+  OutputIterator findMany(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+    ForwardIterator keys[batch_lanes];
+    base_ptr        nodes[batch_lanes];
+    base_ptr        found[batch_lanes];
+
+    while (first != last) {
+      size_type n = 0;
+
+      for (; n < batch_lanes && first != last; ++n, ++first) {
+        keys[n] = first;
+        nodes[n] = this->getRoot();
+        found[n] = this->endNode();
+      }
+      for (size_type active = n; active;) {
+        active = 0;
+        for (size_type i = 0; i < n; i++) {
+          base_ptr x = nodes[i];
+
+          if (!x) continue;
+          if (this->_comp(*keys[i], keyOf(x)))
+            x = x->left;
+          else if (this->_comp(keyOf(x), *keys[i]))
+            x = x->right;
+          else {
+            found[i] = x;
+            x = nullptr;
+          }
+          if (x) {
+            prefetch(x);
+            active++;
+          }
+          nodes[i] = x;
+        }
+      }
+      for (size_type i = 0; i < n; i++, ++out) *out = iterator(found[i]);
+    }
+    return out;
+  }
+
+  // a hint to load the node into the cache, it's not waited for
+  static void prefetch(base_ptr x) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(x);
+#else
+    (void)x;
+#endif
+  }
+
+  // the range of the key `k` in a single descent : down to the first node of the key, then the lower bound
+  // of its left subtree & the upper bound of its right subtree (the equal keys are around it)
+  template <class K>
+  ft::pair<iterator, iterator> equalRange(const K &k) const {
+    base_ptr x = this->getRoot();
+    base_ptr upper = this->endNode();
+
+    while (x) {
+      if (this->_comp(keyOf(x), k))
+        x = x->right;
+      else if (this->_comp(k, keyOf(x))) {
+        upper = x;
+        x = x->left;
+      } else {
+        base_ptr lower = x;
+        for (base_ptr y = x->left; y;) {
+          if (this->_comp(keyOf(y), k))
+            y = y->right;
+          else {
+            lower = y;
+            y = y->left;
+          }
+        }
+        for (base_ptr y = x->right; y;) {
+          if (this->_comp(k, keyOf(y))) {
+            upper = y;
+            y = y->left;
+          } else
+            y = y->right;
+        }
+        return ft::make_pair(iterator(lower), iterator(upper));
+      }
     }
-    return const_iterator(iter);
+    return ft::make_pair(iterator(upper), iterator(upper));
+  }
+
+  // the number of values of the key `k`, O(log n + their number)
+  template <class K>
+  size_type countEqual(const K &k) const {
+    ft::pair<iterator, iterator> range = this->equalRange(k);
+
+    return this->countRange(range.first.base(), range.second.base());
+  }
+
+  size_type countRange(base_ptr first, base_ptr last) const {
+    size_type n = 0;
+
+    for (; first != last; first = base_type::getSuccessor(first)) n++;
+    return n;
   }
 
-  iterator upper_bound(const value_type &k) {
-    pointer  node = this->_root;
+  // the first node of the key `k` (the equal trees may hold several), or the end
+  template <class K>
+  iterator findFirst(const K &k) const {
+    iterator it = this->lower_bound(k);
+
+    return it == this->end() || this->_comp(k, keyOf(it.base())) ? this->end() : it;
+  }
+
+  void rotate(base_ptr node, short side) {
+    if (side == LEFT_SIDE)
+      this->leftRotate(node);
+    else
+      this->rightRotate(node);
+  }
+
+  void leftRotate(base_ptr x) {
+    base_ptr y = x->right;
+    x->right = y->left;
+    if (y->left) {
+      y->left->setParent(x);
+    }
+    this->transplant(x, y);
+    y->left = x;
+    x->setParent(y);
+    this->pull(x);
+    this->pull(y);
+  }
+
+  void rightRotate(base_ptr x) {
+    base_ptr y = x->left;
+    x->left = y->right;
+    if (y->right) {
+      y->right->setParent(x);
+    }
+    this->transplant(x, y);
+    y->right = x;
+    x->setParent(y);
+    this->pull(x);
+    this->pull(y);
+  }
+
+  template <class K>
+  iterator lower_bound(const K &k) const {
+    base_ptr node = this->getRoot();
     iterator iter = this->end();
 
-    while (!node->isNil()) {
-      if (this->_comp(k, node->data)) {
+    while (node) {
+      if (!this->_comp(keyOf(node), k)) {
         iter = iterator(node);
         node = node->left;
       } else
         node = node->right;
     }
-    return iterator(iter);
+    return iter;
   }
-  const_iterator upper_bound(const value_type &k) const {
-    pointer  node = this->_root;
+
+  template <class K>
+  iterator upper_bound(const K &k) const {
+    base_ptr node = this->getRoot();
     iterator iter = this->end();
 
-    while (!node->isNil()) {
-      if (this->_comp(k, node->data)) {
+    while (node) {
+      if (this->_comp(k, keyOf(node))) {
         iter = iterator(node);
         node = node->left;
       } else
         node = node->right;
     }
-    return const_iterator(iter);
+    return iter;
   }
 
-  void test(ostream &stream) const { node_type::dump_dot(this->_root, stream); }
+  void test(ostream &stream) const { node_type::dump_dot(this->getRoot(), stream); }
 };
 }  // namespace ft
 
-#endif
\ No newline at end of file
+#endif
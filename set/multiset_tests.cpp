@@ -0,0 +1,123 @@
+#include "tests.hpp"
+
+// the equal values of a multiset can still be told apart by what they don't compare on
+struct by_tens {
+  bool operator()(int lhs, int rhs) const { return lhs / 10 < rhs / 10; }
+};
+
+typedef ft::multiset<int, by_tens> tens_multiset;
+
+template <class Set>
+static void print(const char* name, const Set& myset) {
+  std::cout << name << " contains:";
+  for (typename Set::const_iterator it = myset.begin(); it != myset.end(); ++it) std::cout << ' ' << *it;
+  std::cout << '\n';
+}
+
+static void test_insert(void) {
+  tens_multiset           myset;
+  tens_multiset::iterator it;
+
+  for (int i = 0; i < 5; i++) myset.insert(i * 10 + i);  // 0 11 22 33 44
+  it = myset.insert(23);
+  std::cout << "inserted: " << *it << '\n';
+
+  myset.insert(it, 24);              // right before 23
+  myset.insert(myset.find(44), 25);  // after the other 2x
+  myset.insert(myset.begin(), 26);   // wrong hint
+  myset.insert(myset.end(), 47);
+  myset.insert(myset.end(), 27);  // wrong hint
+  print("myset", myset);
+
+  int values[] = {5, 1, 48, 2, 49};
+  myset.insert(values, values + 5);
+  print("myset", myset);
+
+  tens_multiset sorted(myset.begin(), myset.end());
+  print("sorted", sorted);
+  std::cout << "equal: " << (sorted == myset) << '\n';
+}
+
+static void test_count(void) {
+  ft::multiset<int> myset;
+
+  for (int i = 0; i < 100; i++) myset.insert(i % 10 < 5 ? i % 10 : 9);
+
+  for (int k = -1; k <= 10; k++) std::cout << k << ':' << myset.count(k) << ' ';
+  std::cout << '\n';
+  std::cout << "lower 7: " << *myset.lower_bound(7) << ", upper 4: " << *myset.upper_bound(4) << ", find 9: " << (myset.find(9) != myset.end()) << '\n';
+}
+
+static void test_equal_range(void) {
+  tens_multiset myset;
+
+  for (int i = 0; i < 60; i++) myset.insert((i * 37) % 60);
+
+  for (int k = -10; k <= 60; k += 10) {
+    ft::pair<tens_multiset::iterator, tens_multiset::iterator> range = myset.equal_range(k);
+    std::cout << k << ':';
+    for (tens_multiset::iterator it = range.first; it != range.second; ++it) std::cout << ' ' << *it;
+    std::cout << '\n';
+  }
+}
+
+static void test_erase(void) {
+  tens_multiset myset;
+
+  for (int i = 0; i < 50; i++) myset.insert(i);
+
+  std::cout << "erase 15: " << myset.erase(15);
+  std::cout << ", erase 10: " << myset.erase(10);
+  std::cout << ", erase 41: " << myset.erase(41) << '\n';
+  myset.erase(myset.find(0));
+  myset.erase(myset.begin());
+  tens_multiset::iterator first = myset.find(22);
+  ++first;
+  ++first;
+  myset.erase(first, myset.upper_bound(35));
+  print("myset", myset);
+
+  myset.erase(myset.begin(), myset.end());
+  std::cout << "size: " << myset.size() << ", erase 0: " << myset.erase(0) << '\n';
+}
+
+static void test_relational_operators(void) {
+  int               a[] = {1, 2, 2, 3};
+  int               b[] = {1, 2, 3, 3};
+  ft::multiset<int> foo(a, a + 4);
+  ft::multiset<int> bar(b, b + 4);
+  ft::multiset<int> baz(a, a + 4);
+
+  std::cout << (foo == baz) << (foo != bar) << (foo < bar) << (bar > foo) << (foo <= baz) << (bar >= foo) << '\n';
+  foo.swap(bar);
+  print("foo", foo);
+  print("bar", bar);
+}
+
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+  ft::multiset<std::string> myset;
+  std::string               word("word");
+
+  myset.insert(std::move(word));
+  myset.emplace(3, 'z');
+  myset.emplace("word");
+  myset.emplace_hint(myset.begin(), "alpha");
+
+  ft::multiset<std::string> moved;
+  moved = std::move(myset);
+  std::cout << "myset size: " << myset.size() << ", word count: " << moved.count("word") << '\n';
+  print("moved", moved);
+}
+#endif
+
+void multiset_main() {
+  start_test("Test insert", test_insert);
+  start_test("Test count", test_count);
+  start_test("Test equal_range", test_equal_range);
+  start_test("Test erase", test_erase);
+  start_test("Test relational operators", test_relational_operators);
+#if __cplusplus >= 201103L
+  start_test("Test move semantics", test_move_semantics);
+#endif
+}
@@ -5,16 +5,20 @@
 #include <memory>
 
 #include "equal.hpp"
+#include "functional.hpp"
 #include "iterator_traits.hpp"
 #include "lexicographical_compare.hpp"
+#include "move.hpp"
 #include "pair.hpp"
 #include "red_black_tree.hpp"
+#include "thread_pool.hpp"
 
 namespace ft {
 
-template <class T,                    // set::key_type/value_type
-          class Compare = less<T>,    // set::key_compare/value_compare
-          class Alloc = allocator<T>  // set::allocator_type
+template <class T,                             // set::key_type/value_type
+          class Compare = less<T>,             // set::key_compare/value_compare
+          class Alloc = allocator<T>,          // set::allocator_type
+          class NodePolicy = ft::compact_node  // layout of the tree nodes (see node_policy.hpp)
           >
 class set {
  public:
@@ -30,8 +34,8 @@ class set {
   typedef typename allocator_type::const_pointer   const_pointer;
 
  private:
-  typedef RedBlackTree<value_type, value_compare, allocator_type> RBT;
-  RBT                                                             tree;
+  typedef RedBlackTree<key_type, value_type, ft::identity<value_type>, key_compare, allocator_type, NodePolicy> RBT;
+  RBT                                                                               tree;
 
   allocator_type _alloc;
   key_compare    _key_comp;
@@ -44,6 +48,9 @@ class set {
   typedef ft::reverse_iterator<const_iterator>     const_reverse_iterator;
   typedef typename allocator_type::difference_type difference_type;
   typedef typename allocator_type::size_type       size_type;
+  // a node taken out of the set by extract, to go into a set by insert without being copied (see node_handle.hpp)
+  typedef ft::node_handle<typename RBT::node_type, typename RBT::node_alloc> node_type;
+  typedef ft::insert_return_type<iterator, node_type>                        insert_return_type;
 
  public:
   // the default constructor
@@ -70,6 +77,19 @@ class set {
     return *this;
   }
 
+#if FT_CXX11
+  // move constructor
+  set(set&& x) : tree(std::move(x.tree)), _alloc(x._alloc), _key_comp(x._key_comp), _value_comp(x._value_comp) {}
+
+  // move assignment operator
+  set& operator=(set&& x) {
+    if (this != &x) {
+      this->tree = std::move(x.tree);
+    }
+    return *this;
+  }
+#endif
+
   // Iterators
   iterator       begin() { return tree.begin(); };
   const_iterator begin() const { return tree.begin(); };
@@ -91,41 +111,78 @@ class set {
   // Modifiers
 
   pair<iterator, bool> insert(const value_type& val) {
-    ft::pair<bool, typename RBT::pointer> ret = tree.insertUnique(val);
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUnique(val);
 
     return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
   }
 
-  iterator insert(iterator position, const value_type& val) {
-    (void)position;  // i don't use hint in my implementation
-    return this->insert(val).first;
+  // linked next to the hint without a descent when the value goes right before or right after it
+  iterator insert(iterator position, const value_type& val) { return iterator(tree.insertUnique(position.base(), val).second); }
+
+#if FT_CXX11
+  pair<iterator, bool> insert(value_type&& val) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUnique(std::move(val));
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
   }
 
+  iterator insert(iterator position, value_type&& val) { return iterator(tree.insertUnique(position.base(), std::move(val)).second); }
+
+  template <class... Args>
+  pair<iterator, bool> emplace(Args&&... args) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.emplaceUnique(std::forward<Args>(args)...);
+
+    return ft::pair<iterator, bool>(iterator(ret.second), ret.first);
+  }
+
+  template <class... Args>
+  iterator emplace_hint(iterator position, Args&&... args) {
+    return iterator(tree.emplaceHintUnique(position.base(), std::forward<Args>(args)...).second);
+  }
+#endif
+
+  // sorted ranges are built in O(n) in an empty container, or linked without descents (each value hinted with the previous one)
   template <class InputIterator>
   void insert(InputIterator first, InputIterator last) {
-    while (first != last) {
-      this->insert(*first);
-      first++;
-    }
+    tree.insertUniqueRange(first, last);
   }
 
-  void      erase(iterator position) { tree.deleteNode(*position); }
+  // the same, a sorted random access range is built on the threads of the pool in an empty container (see thread_pool.hpp)
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last, ft::thread_pool& pool) {
+    tree.insertUniqueRange(first, last, pool);
+  }
+
+  // the iterator erasures unlink their nodes directly, without searching them
+  void      erase(iterator position) { tree.eraseNode(position.base()); }
   size_type erase(const key_type& k) { return tree.deleteNode(k); }
-  void      erase(iterator first, iterator last) {
-    while (first != last) {
-      iterator tmp(first);
-      tmp++;
-      this->erase(first);
-      first = tmp;
-    }
+  void      erase(iterator first, iterator last) { tree.eraseRange(first.base(), last.base()); }
+
+  // the node of the element leaves the set in the handle, an empty handle when the key isn't there
+  node_type extract(iterator position) { return tree.template extractNode<node_type>(position.base()); }
+  node_type extract(const key_type& k) {
+    iterator it = this->find(k);
+
+    return it == this->end() ? node_type() : this->extract(it);
   }
 
-  void swap(set& x) {
-    RBT tmp(x.tree);
+  // the node of the handle is linked as it is when its key isn't here, it's given back in the result otherwise
+  insert_return_type insert(node_type nh) {
+    ft::pair<bool, typename RBT::base_ptr> ret = tree.insertUniqueNode(nh);
+    insert_return_type                     result;
 
-    x.tree = this->tree;
-    this->tree = tmp;
-    // std::swap(this->tree, x.tree); // this would be better than above !!
+    result.position = iterator(ret.second);
+    result.inserted = ret.first;
+    result.node = FT_MOVE(nh);
+    return result;
+  }
+
+  // constant time, no element is copied or moved
+  void swap(set& x) {
+    this->tree.swap(x.tree);
+    std::swap(this->_alloc, x._alloc);
+    std::swap(this->_key_comp, x._key_comp);
+    std::swap(this->_value_comp, x._value_comp);
   }
 
   void clear() { tree.clear(); }
@@ -136,20 +193,8 @@ class set {
 
   // Operations
 
-  iterator find(const key_type& k) {
-    typename RBT::pointer exists = tree.find(k);
-
-    if (exists->isNil()) return this->end();
-
-    return iterator(exists);
-  }
-  const_iterator find(const key_type& k) const {
-    typename RBT::pointer exists = tree.find(k);
-
-    if (exists->isNil()) return this->end();
-
-    return const_iterator(exists);
-  }
+  iterator       find(const key_type& k) { return tree.find(k); }
+  const_iterator find(const key_type& k) const { return tree.find(k); }
 
   size_type count(const key_type& k) const { return this->find(k) != this->end(); }
 
@@ -162,6 +207,82 @@ class set {
   ft::pair<iterator, iterator>             equal_range(const key_type& k) { return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
   ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k)); }
 
+  // the iterator of each key of [first, last) (or the end), written to `out` in the order of the keys : the descents
+  // of several keys are interleaved & prefetch their next node, the lookups of a large set wait less on the memory
+  template <class ForwardIterator, class OutputIterator>
+  OutputIterator find_many(ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+    return tree.findMany(first, last, out);
+  }
+
+  // heterogeneous lookups, only with a transparent comparator (declaring `is_transparent`) :
+  // the key is compared as it is, ex: a std::string key with a const char * without building a std::string
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type find(const K& k) {
+    return tree.find(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type find(const K& k) const {
+    return tree.find(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, size_type>::type count(const K& k) const {
+    return tree.find(k) != tree.end();
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type lower_bound(const K& k) {
+    return tree.lower_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type lower_bound(const K& k) const {
+    return tree.lower_bound(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, iterator>::type upper_bound(const K& k) {
+    return tree.upper_bound(k);
+  }
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, const_iterator>::type upper_bound(const K& k) const {
+    return tree.upper_bound(k);
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<iterator, iterator> >::type equal_range(const K& k) {
+    return ft::pair<iterator, iterator>(tree.lower_bound(k), tree.upper_bound(k));
+  }
+
+  template <class K>
+  typename ft::transparent_lookup<Compare, K, ft::pair<const_iterator, const_iterator> >::type equal_range(const K& k) const {
+    return ft::pair<const_iterator, const_iterator>(tree.lower_bound(k), tree.upper_bound(k));
+  }
+
+  // order statistics, only with a NodePolicy counting the nodes (ft::counted_node) : O(log n) without walking the elements
+  iterator        nth(size_type k) { return tree.nth(k); }
+  const_iterator  nth(size_type k) const { return tree.nth(k); }
+  size_type       rank(const key_type& k) const { return tree.rank(k); }  // the number of keys less than k
+  difference_type distance(const_iterator first, const_iterator last) const { return tree.distance(first.base(), last.base()); }
+
+  // range aggregates, only with a NodePolicy summarizing the values by a monoid (ft::augmented_node) :
+  // the combination of the values whose key is in [lo, hi), in O(log n)
+  typedef typename RBT::summary_type summary_type;
+
+  summary_type aggregate(const key_type& lo, const key_type& hi) const { return tree.aggregate(lo, hi); }
+
+  // set algebra by splitting & joining the trees : O(m log(n/m + 1)) for m <= n elements, the nodes move from tree
+  // to tree (no element is copied, unless the allocators can't share their nodes)
+  void merge(set& x) { tree.merge(x.tree); }                           // the elements of x whose key isn't here move here, the others stay in x
+  void set_union(set& x) { tree.unionWith(x.tree); }                   // x is left empty, the elements here win over the equal ones of x
+  void set_intersection(const set& x) { tree.intersectWith(x.tree); }  // the elements here whose key is in x
+  void set_difference(const set& x) { tree.subtract(x.tree); }         // the elements here whose key isn't in x
+
+  // the same on the threads of the pool : both sides of each split go to two threads, down to the grain of the pool
+  void merge(set& x, ft::thread_pool& pool) { tree.merge(x.tree, &pool); }
+  void set_union(set& x, ft::thread_pool& pool) { tree.unionWith(x.tree, &pool); }
+  void set_intersection(const set& x, ft::thread_pool& pool) { tree.intersectWith(x.tree, &pool); }
+  void set_difference(const set& x, ft::thread_pool& pool) { tree.subtract(x.tree, &pool); }
+
   // Allocator
   allocator_type get_allocator() const { return this->_alloc; }
 
@@ -172,36 +293,41 @@ class set {
 };
 
 // relational operators for set
-template <class Key, class Compare, class Alloc>
-bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator==(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
 }
 
-template <class Key, class Compare, class Alloc>
-bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator!=(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class Key, class Compare, class Alloc>
-bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator<(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class Key, class Compare, class Alloc>
-bool operator<=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator<=(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class Key, class Compare, class Alloc>
-bool operator>(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator>(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return rhs < lhs;
 }
 
-template <class Key, class Compare, class Alloc>
-bool operator>=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+template <class Key, class Compare, class Alloc, class NodePolicy>
+bool operator>=(const set<Key, Compare, Alloc, NodePolicy>& lhs, const set<Key, Compare, Alloc, NodePolicy>& rhs) {
   return !(lhs < rhs);
 }
 
+template <class Key, class Compare, class Alloc, class NodePolicy>
+void swap(set<Key, Compare, Alloc, NodePolicy>& x, set<Key, Compare, Alloc, NodePolicy>& y) {
+  x.swap(y);
+}
+
 }  // namespace ft
 
 #endif
\ No newline at end of file
@@ -6,6 +6,121 @@ struct classcomp {
   bool operator()(const int& lhs, const int& rhs) const { return lhs < rhs; }
 };
 
+// std has no order statistics, the std build gets the same answers by walking the set
+#if STD
+typedef std::set<int> counted_set;
+
+static counted_set::iterator nth_of(const counted_set& s, size_t k) {
+  counted_set::iterator it = s.begin();
+  while (k-- && it != s.end()) ++it;
+  return it;
+}
+static size_t rank_of(const counted_set& s, int k) { return std::distance(s.begin(), s.lower_bound(k)); }
+static long   distance_of(const counted_set&, counted_set::iterator first, counted_set::iterator last) { return std::distance(first, last); }
+#else
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::counted_node<> > counted_set;
+
+static counted_set::iterator nth_of(const counted_set& s, size_t k) { return s.nth(k); }
+static size_t                rank_of(const counted_set& s, int k) { return s.rank(k); }
+static long                  distance_of(const counted_set& s, counted_set::iterator first, counted_set::iterator last) { return s.distance(first, last); }
+#endif
+
+// std has no set algebra on the sets themselves (nor merge before C++17), the std build does it element by element
+#if STD
+template <class Set>
+static void merge_of(Set& dst, Set& src) {
+  for (typename Set::iterator it = src.begin(); it != src.end();) {
+    if (dst.insert(*it).second)
+      src.erase(it++);
+    else
+      ++it;
+  }
+}
+template <class Set>
+static void union_of(Set& dst, Set& src) {
+  dst.insert(src.begin(), src.end());
+  src.clear();
+}
+template <class Set>
+static void intersection_of(Set& dst, const Set& other) {
+  for (typename Set::iterator it = dst.begin(); it != dst.end();) {
+    if (other.count(*it))
+      ++it;
+    else
+      dst.erase(it++);
+  }
+}
+template <class Set>
+static void difference_of(Set& dst, const Set& other) {
+  for (typename Set::const_iterator it = other.begin(); it != other.end(); ++it) dst.erase(*it);
+}
+
+// nor threads in the containers : the std build takes the sequential way
+struct parallel_pool {
+  parallel_pool(size_t, size_t) {}
+};
+template <class Set, class Iterator>
+static void parallel_build(Set& dst, Iterator first, Iterator last, parallel_pool&) {
+  dst.insert(first, last);
+}
+template <class Set>
+static void parallel_union(Set& dst, Set& src, parallel_pool&) {
+  union_of(dst, src);
+}
+template <class Set>
+static void parallel_merge(Set& dst, Set& src, parallel_pool&) {
+  merge_of(dst, src);
+}
+template <class Set>
+static void parallel_intersection(Set& dst, const Set& other, parallel_pool&) {
+  intersection_of(dst, other);
+}
+template <class Set>
+static void parallel_difference(Set& dst, const Set& other, parallel_pool&) {
+  difference_of(dst, other);
+}
+#else
+template <class Set>
+static void merge_of(Set& dst, Set& src) {
+  dst.merge(src);
+}
+template <class Set>
+static void union_of(Set& dst, Set& src) {
+  dst.set_union(src);
+}
+template <class Set>
+static void intersection_of(Set& dst, const Set& other) {
+  dst.set_intersection(other);
+}
+template <class Set>
+static void difference_of(Set& dst, const Set& other) {
+  dst.set_difference(other);
+}
+
+typedef ft::thread_pool parallel_pool;
+
+template <class Set, class Iterator>
+static void parallel_build(Set& dst, Iterator first, Iterator last, parallel_pool& pool) {
+  dst.insert(first, last, pool);
+}
+template <class Set>
+static void parallel_union(Set& dst, Set& src, parallel_pool& pool) {
+  dst.set_union(src, pool);
+}
+template <class Set>
+static void parallel_merge(Set& dst, Set& src, parallel_pool& pool) {
+  dst.merge(src, pool);
+}
+template <class Set>
+static void parallel_intersection(Set& dst, const Set& other, parallel_pool& pool) {
+  dst.set_intersection(other, pool);
+}
+template <class Set>
+static void parallel_difference(Set& dst, const Set& other, parallel_pool& pool) {
+  dst.set_difference(other, pool);
+}
+#endif
+
 static void test_constructor(void) {
   ft::set<int> first;  // empty set of ints
 
@@ -120,6 +235,19 @@ static void test_insert(void) {
   std::cout << '\n';
 }
 
+static void test_insert_unique(void) {
+  ft::set<int> myset;
+  int          inserted = 0;
+
+  // every key comes twice, in a scrambled order
+  for (int i = 0; i < 200; i++) inserted += myset.insert((i * 37) % 100).second;
+
+  std::cout << "inserted " << inserted << ", size " << myset.size() << '\n';
+  for (ft::set<int>::iterator it = myset.begin(); it != myset.end(); it++)
+    if (*it % 10 == 0) std::cout << ' ' << *it;
+  std::cout << '\n';
+}
+
 static void test_erase(void) {
   ft::set<int>           myset;
   ft::set<int>::iterator it;
@@ -142,6 +270,50 @@ static void test_erase(void) {
   std::cout << '\n';
 }
 
+static void test_extremes(void) {
+  ft::set<int> myset;
+
+  for (int i = 0; i < 20; i++) {
+    myset.insert((i * 7) % 20 - 10);
+    std::cout << *myset.begin() << "/" << *myset.rbegin() << ' ';
+  }
+  std::cout << '\n';
+  while (myset.size() > 1) {
+    myset.erase(myset.size() % 2 ? myset.begin() : --myset.end());
+    std::cout << *myset.begin() << "/" << *myset.rbegin() << ' ';
+  }
+  std::cout << '\n';
+  myset.clear();
+  myset.insert(42);
+  std::cout << *myset.begin() << "/" << *myset.rbegin() << " " << (myset.rbegin().base() == myset.end()) << '\n';
+}
+
+static void test_erase_range(void) {
+  ft::set<int> myset;
+
+  for (int i = 0; i < 100; i++) myset.insert(i);
+
+  // every other element while iterating
+  for (ft::set<int>::iterator it = myset.begin(); it != myset.end();) {
+    ft::set<int>::iterator next = it;
+    ++next;
+    if (*it % 2) myset.erase(it);
+    it = next;
+  }
+  myset.erase(myset.find(40), myset.find(60));
+  myset.erase(myset.begin(), myset.find(10));
+  myset.erase(myset.find(90), myset.end());
+  myset.erase(myset.begin(), myset.begin());
+
+  std::cout << "myset contains:";
+  for (ft::set<int>::iterator it = myset.begin(); it != myset.end(); ++it) std::cout << ' ' << *it;
+  std::cout << '\n';
+
+  myset.erase(myset.begin(), myset.end());
+  myset.insert(7);
+  std::cout << "size: " << myset.size() << " " << *myset.begin() << '\n';
+}
+
 static void test_swap(void) {
   int          myints[] = {12, 75, 10, 32, 20, 25};
   ft::set<int> first(myints, myints + 3);       // 10,12,75
@@ -291,8 +463,115 @@ static void test_get_allocator(void) {
   myset.get_allocator().deallocate(p, 5);
 }
 
+static void test_order_statistics(void) {
+  counted_set myset;
+
+  for (int i = 1; i <= 20; i++) myset.insert(i * 5);
+  std::cout << "nth(0): " << *nth_of(myset, 0) << ", nth(7): " << *nth_of(myset, 7) << ", nth(19): " << *nth_of(myset, 19) << ", nth(20) is end: " << (nth_of(myset, 20) == myset.end()) << '\n';
+  std::cout << "rank(5): " << rank_of(myset, 5) << ", rank(42): " << rank_of(myset, 42) << ", rank(1000): " << rank_of(myset, 1000) << '\n';
+
+  myset.erase(myset.find(40));
+  myset.erase(myset.lower_bound(60), myset.lower_bound(80));
+  myset.insert(37);
+  counted_set copy(myset);
+  std::cout << "size: " << copy.size() << ", nth(7): " << *nth_of(copy, 7) << ", rank(81): " << rank_of(copy, 81) << '\n';
+  std::cout << "distance(begin, end): " << distance_of(copy, copy.begin(), copy.end()) << ", distance(find(50), find(95)): " << distance_of(copy, copy.find(50), copy.find(95)) << '\n';
+  for (size_t k = 0; k < copy.size(); k += 4) std::cout << *nth_of(copy, k) << ' ';
+  std::cout << '\n';
+}
+
+static void print_set(const char* name, const ft::set<int>& myset) {
+  std::cout << name << " (" << myset.size() << "):";
+  for (ft::set<int>::const_iterator it = myset.begin(); it != myset.end(); ++it) std::cout << ' ' << *it;
+  std::cout << '\n';
+}
+
+static void test_set_algebra(void) {
+  ft::set<int> evens, threes;
+
+  for (int i = 0; i <= 30; i += 2) evens.insert(i);
+  for (int i = 0; i <= 30; i += 3) threes.insert(i);
+
+  ft::set<int> inter(evens), diff(evens), merged(evens), other(threes), united(evens), all(threes);
+  intersection_of(inter, threes);
+  difference_of(diff, threes);
+  merge_of(merged, other);
+  union_of(united, all);
+  print_set("intersection", inter);
+  print_set("difference", diff);
+  print_set("merged", merged);
+  print_set("left in the source", other);
+  print_set("union", united);
+  std::cout << "union source empty: " << all.empty() << ", merged == union: " << (merged == united) << '\n';
+
+  // the trees stay usable, with empty & disjoint operands
+  ft::set<int> empty, big;
+  for (int i = 0; i < 1000; i++) big.insert(i * 7 % 1000);
+  union_of(empty, inter);
+  intersection_of(big, united);
+  difference_of(united, empty);
+  merge_of(big, empty);
+  print_set("empty + inter", empty);
+  print_set("big & union", big);
+  big.insert(5);
+  big.erase(6);
+  difference_of(big, evens);
+  print_set("big - evens", big);
+  std::cout << "first: " << *big.begin() << ", last: " << *big.rbegin() << '\n';
+}
+
+// a tiny grain, so that these sets are cut down to a few elements per task
+static void test_parallel_algebra(void) {
+  parallel_pool    pool(4, 8);
+  std::vector<int> sorted;
+
+  for (int i = 0; i < 3000; i++) sorted.push_back(i * 2);
+
+  ft::set<int> evens, thirds, odds;
+  parallel_build(evens, sorted.begin(), sorted.end(), pool);
+  for (int i = 0; i < 6000; i += 3) thirds.insert(i);
+  for (int i = 1; i < 200; i += 2) odds.insert(i);
+  std::cout << "built: " << evens.size() << " " << *evens.begin() << " " << *evens.rbegin() << '\n';
+
+  ft::set<int> inter(evens), diff(evens), merged(evens), other(thirds), united(evens), all(thirds), seq(evens), seq_all(thirds);
+  parallel_intersection(inter, thirds, pool);
+  parallel_difference(diff, thirds, pool);
+  parallel_merge(merged, other, pool);
+  parallel_union(united, all, pool);
+  union_of(seq, seq_all);
+  std::cout << "intersection: " << inter.size() << ", difference: " << diff.size() << ", merged: " << merged.size() << ", left: " << other.size() << '\n';
+  std::cout << "union: " << united.size() << ", same as sequential: " << (united == seq) << ", merged == union: " << (merged == united) << '\n';
+
+  long sum = 0;
+  for (ft::set<int>::iterator it = inter.begin(); it != inter.end(); ++it) sum += *it;
+  std::cout << "sum of the intersection: " << sum << '\n';
+
+  // a small operand & a disjoint one
+  parallel_union(odds, inter, pool);
+  parallel_difference(united, odds, pool);
+  std::cout << "odds + inter: " << odds.size() << ", union - that: " << united.size() << ", first: " << *united.begin() << '\n';
+}
+
 // static void test_relational_operators(void) {}
 
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+  ft::set<std::string> myset;
+  std::string          word("word");
+
+  myset.insert(std::move(word));
+  myset.emplace(3, 'z');
+  myset.emplace_hint(myset.begin(), "alpha");
+  std::cout << "emplace of an existing key: " << myset.emplace("word").second << '\n';
+
+  ft::set<std::string> moved(std::move(myset));
+  std::cout << "myset size: " << myset.size() << '\n';
+  std::cout << "moved contains:";
+  for (ft::set<std::string>::iterator it = moved.begin(); it != moved.end(); ++it) std::cout << ' ' << *it;
+  std::cout << '\n';
+}
+#endif
+
 void set_main() {
   start_test("Test Constructor", test_constructor);
   start_test("Test Assignment Operator", test_assignment_operator);
@@ -302,7 +581,10 @@ void set_main() {
   start_test("Test size", test_size);
   start_test("Test max_size", test_max_size);
   start_test("Test insert", test_insert);
+  start_test("Test insert unique", test_insert_unique);
   start_test("Test erase", test_erase);
+  start_test("Test extremes", test_extremes);
+  start_test("Test erase range", test_erase_range);
   start_test("Test swap", test_swap);
   start_test("Test clear", test_clear);
   start_test("Test key_comp", test_key_comp);
@@ -312,4 +594,10 @@ void set_main() {
   start_test("Test lower/upper bound", test_lower_upper_bound);
   start_test("Test equal_range", test_equal_range);
   start_test("Test get_allocator", test_get_allocator);
+  start_test("Test order statistics", test_order_statistics);
+  start_test("Test set algebra", test_set_algebra);
+  start_test("Test parallel set algebra", test_parallel_algebra);
+#if __cplusplus >= 201103L
+  start_test("Test move semantics", test_move_semantics);
+#endif
 }
\ No newline at end of file
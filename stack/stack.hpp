@@ -1,6 +1,7 @@
 #ifndef __STACK_HPP__
 #define __STACK_HPP__
 
+#include "move.hpp"
 #include "vector.hpp"
 
 namespace ft {
@@ -18,7 +19,7 @@ class stack {
 
  public:
   // default constructor
-  explicit stack(const container_type& ctnr = container_type()) { this->c = ctnr; }
+  explicit stack(const container_type& ctnr = container_type()) : c(ctnr) {}
 
   // copy constructot
   stack(const stack& copy) : c(copy.c) {}
@@ -31,15 +32,36 @@ class stack {
     return *this;
   }
 
+#if FT_CXX11
+  explicit stack(container_type&& ctnr) : c(std::move(ctnr)) {}
+
+  // move constructor
+  stack(stack&& other) : c(std::move(other.c)) {}
+
+  // move assignment operator
+  stack& operator=(stack&& rhs) {
+    c = std::move(rhs.c);
+    return *this;
+  }
+#endif
+
   // member functions
 
   bool      empty() const { return this->c.empty(); }
   size_type size() const { return this->c.size(); }
 
   value_type&       top() { return this->c.back(); }
-  const value_type& top() const { return this->back(); }
+  const value_type& top() const { return this->c.back(); }
 
   void push(const value_type& val) { this->c.push_back(val); }
+#if FT_CXX11
+  void push(value_type&& val) { this->c.push_back(std::move(val)); }
+
+  template <class... Args>
+  void emplace(Args&&... args) {
+    this->c.emplace_back(std::forward<Args>(args)...);
+  }
+#endif
   void pop() { this->c.pop_back(); }
 };
 
@@ -9,10 +9,16 @@ void start_test(const char *test_name, void (*func)(void)) {
 int main() {
   std::cout << "------------------- Start Of vector Tests -------------------\n";
   vector_main();
+  std::cout << "------------------- Start Of small_vector Tests -------------------\n";
+  small_vector_main();
   std::cout << "------------------- Start Of stack Tests -------------------\n";
   stack_main();
   std::cout << "------------------- Start Of map Tests -------------------\n";
   map_main();
   std::cout << "------------------- Start Of set Tests -------------------\n";
   set_main();
+  std::cout << "------------------- Start Of multimap Tests -------------------\n";
+  multimap_main();
+  std::cout << "------------------- Start Of multiset Tests -------------------\n";
+  multiset_main();
 }
\ No newline at end of file
@@ -12,7 +12,10 @@
 namespace ft = std;
 #elif FT
 #include "map.hpp"
+#include "multimap.hpp"
+#include "multiset.hpp"
 #include "set.hpp"
+#include "small_vector.hpp"
 #include "stack.hpp"  // ft::stack
 #include "vector.hpp"
 
@@ -22,7 +25,10 @@ void start_test(const char *test_name, void (*func)(void));
 
 void stack_main(void);
 void vector_main(void);
+void small_vector_main(void);
 void map_main(void);
 void set_main(void);
+void multimap_main(void);
+void multiset_main(void);
 
 #endif
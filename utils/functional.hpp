@@ -0,0 +1,66 @@
+#ifndef __FUNCTIONAL_HPP__
+#define __FUNCTIONAL_HPP__
+
+#include "type_traits.hpp"
+
+// key extractors of the trees : a set stores its keys as they are, a map stores (key, mapped value) pairs.
+// the call operators are templates, so the values of a foreign range (ex: std::pair) give their key too.
+
+namespace ft {
+
+template <class T>
+struct identity {
+    template <class U>
+    const U &operator()(const U &x) const {
+        return x;
+    }
+};
+
+template <class Pair>
+struct select_first {
+    template <class P>
+    const typename P::first_type &operator()(const P &x) const {
+        return x.first;
+    }
+};
+
+// factories of the mapped values (see map::try_emplace_with) : make() gives what the mapped value is built from,
+// & it's only called when the value is built.
+
+template <class T>
+struct default_value {
+    T operator()() const { return T(); }
+};
+
+template <class T>
+struct copy_value {
+    const T &value;
+
+    explicit copy_value(const T &x) : value(x) {}
+    const T &operator()() const { return this->value; }
+};
+
+// is_transparent -> Trait class that identifies whether the comparator Compare declares `is_transparent`,
+// that is whether it compares the keys with other types (ex: std::string with const char *) without converting them.
+
+template <class Compare>
+struct is_transparent {
+   private:
+    template <class U>
+    static char test(typename U::is_transparent *);
+    template <class U>
+    static long test(...);
+
+   public:
+    static const bool value = sizeof(test<Compare>(0)) == sizeof(char);
+};
+
+// transparent_lookup -> `type` is R only when Compare is transparent, the key type K of the lookup
+// is only there to make the condition depend on the lookup template (SFINAE instead of a hard error).
+
+template <class Compare, class K, class R>
+struct transparent_lookup : public enable_if<is_transparent<Compare>::value, R> {};
+
+}  // namespace ft
+
+#endif
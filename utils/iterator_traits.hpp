@@ -1,6 +1,7 @@
 #ifndef __ITERATOR_TRAITS_HPP__
 #define __ITERATOR_TRAITS_HPP__
 
+#include <cstddef>  // ptrdiff_t
 
 namespace ft {
 
@@ -23,7 +24,7 @@ class iterator_traits {
 template <class T>
 class iterator_traits<T *> {
    public:
-    typedef ptrdiff_t                      difference_type;
+    typedef std::ptrdiff_t                 difference_type;
     typedef T                              value_type;
     typedef T                              *pointer;
     typedef T                             &reference;
@@ -33,7 +34,7 @@ class iterator_traits<T *> {
 template <class T>
 class iterator_traits<const T *> {
    public:
-    typedef ptrdiff_t                      difference_type;
+    typedef std::ptrdiff_t                 difference_type;
     typedef T                              value_type;
     typedef const T                       *pointer;
     typedef const T                       &reference;
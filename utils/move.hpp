@@ -0,0 +1,24 @@
+#ifndef __MOVE_HPP__
+#define __MOVE_HPP__
+
+#include <utility>
+
+// the containers are written in c++98, when they are built in c++11 (or later) they also get move semantics.
+// FT_MOVE(x) is an rvalue in c++11 & a plain lvalue (so a copy) in c++98.
+
+// c++98 has no nullptr either, it's a plain null pointer constant there (libc++ already provides one)
+
+#include <cstddef>
+
+#if __cplusplus >= 201103L
+#define FT_CXX11 1
+#define FT_MOVE(x) std::move(x)
+#else
+#define FT_CXX11 0
+#define FT_MOVE(x) (x)
+#ifndef nullptr
+#define nullptr NULL
+#endif
+#endif
+
+#endif
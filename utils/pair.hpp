@@ -2,7 +2,15 @@
 #define __PAIR_HPP__
 #include <utility>
 
+#include "move.hpp"
+#include "type_traits.hpp"
+
 namespace ft {
+
+// tag of the pair constructor building the second member from a factory : `second` is the result of make(),
+// so the value is built once in place (see map::try_emplace)
+struct make_second_t {};
+
 template <class T1, class T2>
 struct pair {
   // member types
@@ -21,6 +29,29 @@ struct pair {
 
   pair(const first_type &a, const second_type &b) : first(a), second(b) {}
 
+  pair(const pair &pr) : first(pr.first), second(pr.second) {}
+
+#if !FT_CXX11
+  template <class Factory>
+  pair(const first_type &a, const Factory &make, make_second_t) : first(a), second(make()) {}
+#endif
+
+#if FT_CXX11
+  pair(pair &&pr) : first(std::move(pr.first)), second(std::move(pr.second)) {}
+
+  template <typename U, typename V>
+  pair(U &&a, V &&b) : first(std::forward<U>(a)), second(std::forward<V>(b)) {}
+
+  template <class U, class Factory>
+  pair(U &&a, const Factory &make, make_second_t) : first(std::forward<U>(a)), second(make()) {}
+
+  pair &operator=(pair &&pr) {
+    this->first = std::move(pr.first);
+    this->second = std::move(pr.second);
+    return *this;
+  }
+#endif
+
   pair &operator=(const pair &pr) {
     if (this != &pr) {
       this->first = pr.first;
@@ -67,6 +98,10 @@ pair<T1, T2> make_pair(T1 x, T2 y) {
   return pair<T1, T2>(x, y);
 }
 
+// the user defined assignment operator hides the triviality of pair, so forward the trait to its members
+template <class T1, class T2>
+struct is_trivially_relocatable<pair<T1, T2> > : public integral_constant<bool, is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
+
 };  // namespace ft
 
 #endif
\ No newline at end of file
@@ -0,0 +1,334 @@
+#ifndef __POOL_ALLOCATOR_HPP__
+#define __POOL_ALLOCATOR_HPP__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "move.hpp"
+#include "type_traits.hpp"
+
+namespace ft {
+
+// pool_allocator -> allocator of single objects carved from big chunks of the upstream allocator.
+// freed objects go to a free list & are reused first, the chunks themselves are only given back to the
+// upstream allocator by release(), once every object of the pool is dead (that's what the trees do on clear).
+// copies of a pool_allocator share the same pool (so trees can share one), a default constructed one owns a new pool.
+// the pool itself is only created by the first allocation : an allocator that never allocates costs nothing,
+// & its copies made before that get their own pool.
+// two pools can be joined into one (see join), the objects of either one can then be given back to any of their
+// allocators : the joined pool only leads to the other one, its allocators move there on their next use.
+// requests of more than one object bypass the pool, the pooled objects must be aligned like a pointer (the tree nodes are).
+
+template <class T, class Alloc = std::allocator<T> >
+class pool_allocator {
+   public:
+    typedef T                                  value_type;
+    typedef T                                 *pointer;
+    typedef const T                           *const_pointer;
+    typedef T                                 &reference;
+    typedef const T                           &const_reference;
+    typedef typename Alloc::size_type          size_type;
+    typedef typename Alloc::difference_type    difference_type;
+    typedef typename Alloc::template rebind<T>::other upstream_type;
+
+    template <class U>
+    struct rebind {
+        typedef pool_allocator<U, typename Alloc::template rebind<U>::other> other;
+    };
+
+    static const size_type first_chunk_size = 32;
+    static const size_type max_chunk_size = 4096;
+
+   private:
+    // a dead object of the pool, linked in the free list
+    struct free_slot {
+        free_slot *next;
+    };
+
+    // the first slots of every chunk keep the chunk list
+    struct chunk_header {
+        chunk_header *next;
+        size_type     size;
+    };
+
+    struct pool {
+        size_type     refs;
+        size_type     live;
+        chunk_header *chunks;
+        free_slot    *free_list;
+        pointer       cursor;  // bump allocation in the newest chunk
+        pointer       limit;
+        size_type     next_chunk_size;
+        pool         *joined;  // the pool holding the chunks of this one since it was joined to it
+        upstream_type upstream;
+
+        pool() : refs(1), live(0), chunks(nullptr), free_list(nullptr), cursor(nullptr), limit(nullptr), next_chunk_size(first_chunk_size), joined(nullptr) {}
+    };
+
+    typedef typename Alloc::template rebind<pool>::other pool_alloc;
+
+    static const size_type header_slots = (sizeof(chunk_header) + sizeof(T) - 1) / sizeof(T);
+
+    // objects smaller than a pointer can't be linked in the free list, they bypass the pool
+    static bool pooled(size_type n) { return n == 1 && sizeof(T) >= sizeof(free_slot); }
+
+    mutable pool *_pool;
+
+    // the pool of this allocator, null before its first allocation. a joined pool is skipped for the one it leads to
+    pool *find_pool(void) const {
+        while (this->_pool && this->_pool->joined) {
+            pool *p = this->_pool->joined;
+
+            p->refs++;
+            drop(this->_pool);
+            this->_pool = p;
+        }
+        return this->_pool;
+    }
+
+    pool *get_pool(void) const {
+        if (!this->find_pool()) {
+            pool_alloc alloc;
+            this->_pool = alloc.allocate(1);
+            ::new (static_cast<void *>(this->_pool)) pool();
+        }
+        return this->_pool;
+    }
+
+    // a reference less to the pool : without references, it's destroyed with its chunks (its objects are dead),
+    // & the pool it was joined to loses the reference it held
+    static void drop(pool *p) {
+        while (p && !--p->refs) {
+            pool      *next = p->joined;
+            pool_alloc alloc;
+
+            free_chunks(p);
+            p->~pool();
+            alloc.deallocate(p, 1);
+            p = next;
+        }
+    }
+
+    static void free_chunks(pool *p) {
+        while (p->chunks) {
+            chunk_header *next = p->chunks->next;
+            p->upstream.deallocate(reinterpret_cast<pointer>(p->chunks), p->chunks->size);
+            p->chunks = next;
+        }
+        p->free_list = nullptr;
+        p->cursor = p->limit = nullptr;
+        p->next_chunk_size = first_chunk_size;
+    }
+
+    void unref(void) {
+        drop(this->_pool);
+        this->_pool = nullptr;
+    }
+
+    // link a chunk of `size` slots to the pool, returns its first free slot
+    pointer new_chunk(pool *p, size_type size) {
+        pointer       slots = p->upstream.allocate(size);
+        chunk_header *header = reinterpret_cast<chunk_header *>(slots);
+
+        header->next = p->chunks;
+        header->size = size;
+        p->chunks = header;
+        return slots + header_slots;
+    }
+
+    void add_chunk(pool *p) {
+        p->cursor = this->new_chunk(p, p->next_chunk_size);
+        p->limit = p->cursor + p->next_chunk_size - header_slots;
+        if (p->next_chunk_size < max_chunk_size) p->next_chunk_size *= 2;
+    }
+
+   public:
+    pool_allocator() : _pool(nullptr) {}
+
+    pool_allocator(const pool_allocator &copy) : _pool(copy._pool) {
+        if (this->_pool) this->_pool->refs++;
+    }
+
+    template <class U, class A>
+    pool_allocator(const pool_allocator<U, A> &copy) : _pool(nullptr) {
+        (void)copy;
+    }
+
+    pool_allocator &operator=(const pool_allocator &rhs) {
+        if (this != &rhs && this->_pool != rhs._pool) {
+            this->unref();
+            this->_pool = rhs._pool;
+            if (this->_pool) this->_pool->refs++;
+        }
+        return *this;
+    }
+
+    ~pool_allocator() { this->unref(); }
+
+    pointer allocate(size_type n, const void *hint = 0) {
+        (void)hint;
+        pool *p = this->get_pool();
+
+        if (!pooled(n)) return p->upstream.allocate(n);
+
+        if (p->free_list) {
+            free_slot *slot = p->free_list;
+            p->free_list = slot->next;
+            p->live++;
+            return reinterpret_cast<pointer>(slot);
+        }
+        if (p->cursor == p->limit) this->add_chunk(p);  // may throw, nothing is counted yet
+        p->live++;
+        return p->cursor++;
+    }
+
+    // n objects in a row (in a chunk of their own), each one is given back on its own with deallocate(p, 1)
+    pointer allocate_bulk(size_type n) {
+        pool *p = this->get_pool();
+
+        if (!pooled(1)) return nullptr;
+        pointer block = this->new_chunk(p, n + header_slots);
+        p->live += n;
+        return block;
+    }
+
+    void deallocate(pointer ptr, size_type n) {
+        pool *p = this->find_pool();
+
+        if (!pooled(n)) return p->upstream.deallocate(ptr, n);
+
+        free_slot *slot = reinterpret_cast<free_slot *>(ptr);
+        slot->next = p->free_list;
+        p->free_list = slot;
+        p->live--;
+    }
+
+    // true when the `n` objects of the caller are the only live objects of the pool
+    bool holds_only(size_type n) const {
+        pool *p = this->find_pool();
+
+        return p && n && p->live == n;
+    }
+
+    // give every chunk back to the upstream allocator, only possible when no object of the pool is alive.
+    // the `dropped` objects are dead & counted out without going through deallocate() (see holds_only).
+    bool release(size_type dropped = 0) {
+        pool *p = this->find_pool();
+
+        if (!p || p->live != dropped) return false;
+        p->live = 0;
+        free_chunks(p);
+        return true;
+    }
+
+    // the objects of `other` & the ones of this allocator can be given back to either of them from now on :
+    // the pool of `other` joins this one with its chunks, its free slots & its live objects, then `other` & its
+    // copies follow to this pool. O(chunks + free slots of the joined pool)
+    void join(const pool_allocator &other) {
+        pool *p = this->get_pool();
+        pool *from = other.find_pool();
+
+        if (from == p) return;
+        if (!from) {
+            other._pool = p;
+            p->refs++;
+            return;
+        }
+        if (from->chunks) {
+            chunk_header *last = from->chunks;
+            while (last->next) last = last->next;
+            last->next = p->chunks;
+            p->chunks = from->chunks;
+        }
+        if (from->free_list) {
+            free_slot *tail = from->free_list;
+            while (tail->next) tail = tail->next;
+            tail->next = p->free_list;
+            p->free_list = from->free_list;
+        }
+        p->live += from->live;
+        from->live = 0;
+        from->chunks = nullptr;
+        from->free_list = nullptr;
+        from->cursor = from->limit = nullptr;
+        from->joined = p;
+        p->refs++;
+    }
+
+    void construct(pointer p, const_reference val) { ::new (static_cast<void *>(p)) T(val); }
+#if FT_CXX11
+    template <class U, class... Args>
+    void construct(U *p, Args &&...args) {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+#endif
+    void destroy(pointer p) { p->~T(); }
+
+    pointer       address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+    size_type     max_size() const { return upstream_type().max_size(); }
+
+    bool operator==(const pool_allocator &rhs) const { return this->find_pool() == rhs.find_pool(); }
+    bool operator!=(const pool_allocator &rhs) const { return !(*this == rhs); }
+};
+
+// the nodes of the trees come from a pool_allocator layered on the user allocator,
+// specialize this trait to false_type to allocate every node straight from the user allocator instead.
+template <class Alloc>
+struct use_node_pool : public true_type {};
+
+// release the chunks of a pool allocator (`dropped` of its objects are dead without being deallocated),
+// a no-op for the other allocators
+template <class Alloc>
+bool release_pool(Alloc &alloc, typename Alloc::size_type dropped = 0) {
+    (void)alloc, (void)dropped;
+    return false;
+}
+
+template <class T, class Alloc>
+bool release_pool(pool_allocator<T, Alloc> &alloc, typename pool_allocator<T, Alloc>::size_type dropped = 0) {
+    return alloc.release(dropped);
+}
+
+// whether the n objects are all the live objects of a pool allocator, always false for the other allocators :
+// the objects can then be dropped at once by release_pool(alloc, n)
+template <class Alloc>
+bool pool_holds_only(const Alloc &alloc, typename Alloc::size_type n) {
+    (void)alloc, (void)n;
+    return false;
+}
+
+template <class T, class Alloc>
+bool pool_holds_only(const pool_allocator<T, Alloc> &alloc, typename pool_allocator<T, Alloc>::size_type n) {
+    return alloc.holds_only(n);
+}
+
+// whether the objects of `other` can be given back to `alloc` from now on : a pool allocator joins the pool of
+// `other` to its own (see pool_allocator::join), the other allocators must compare equal
+template <class Alloc>
+bool join_pool(Alloc &alloc, const Alloc &other) {
+    return alloc == other;
+}
+
+template <class T, class Alloc>
+bool join_pool(pool_allocator<T, Alloc> &alloc, const pool_allocator<T, Alloc> &other) {
+    alloc.join(other);
+    return true;
+}
+
+// n objects in a row from a pool allocator, null for the other allocators (the objects are then allocated one by one)
+template <class Alloc>
+typename Alloc::pointer allocate_bulk(Alloc &alloc, typename Alloc::size_type n) {
+    (void)alloc, (void)n;
+    return nullptr;
+}
+
+template <class T, class Alloc>
+typename pool_allocator<T, Alloc>::pointer allocate_bulk(pool_allocator<T, Alloc> &alloc, typename pool_allocator<T, Alloc>::size_type n) {
+    return alloc.allocate_bulk(n);
+}
+
+}  // namespace ft
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef __RELOCATE_HPP__
+#define __RELOCATE_HPP__
+
+#include <algorithm>
+#include <cstring>
+
+#include "move.hpp"
+#include "type_traits.hpp"
+
+// relocation engine used by the contiguous containers, every function dispatches on the type traits of T :
+// trivial types are handled with a single bulk memcpy/memmove, the others element by element through the allocator.
+
+namespace ft {
+
+// construct_range -> copy construct [first, last) into the raw storage starting at dest.
+
+template <class Alloc, class T>
+void construct_range(Alloc &alloc, const T *first, const T *last, T *dest, ft::true_type) {
+    (void)alloc;
+    if (first != last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+}
+
+template <class Alloc, class T>
+void construct_range(Alloc &alloc, const T *first, const T *last, T *dest, ft::false_type) {
+    for (; first != last; ++first, ++dest) alloc.construct(dest, *first);
+}
+
+template <class Alloc, class T>
+void construct_range(Alloc &alloc, const T *first, const T *last, T *dest) {
+    ft::construct_range(alloc, first, last, dest, ft::is_trivially_copyable<T>());
+}
+
+// destroy_range -> call the destructor of every element of [first, last).
+
+template <class Alloc, class T>
+void destroy_range(Alloc &alloc, T *first, T *last) {
+    for (; first != last; ++first) alloc.destroy(first);
+}
+
+// assign_range -> copy assign [first, last) over the live elements starting at dest, the ranges must not overlap.
+
+template <class T>
+void assign_range(const T *first, const T *last, T *dest, ft::true_type) {
+    if (first != last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+}
+
+template <class T>
+void assign_range(const T *first, const T *last, T *dest, ft::false_type) {
+    std::copy(first, last, dest);
+}
+
+template <class T>
+void assign_range(const T *first, const T *last, T *dest) {
+    ft::assign_range(first, last, dest, ft::is_trivially_copyable<T>());
+}
+
+// relocate_range -> move [first, last) to the raw storage starting at dest, the source is left raw.
+// the ranges may overlap in both directions, that's what insert & erase use to open or close a gap.
+// non trivial elements are move constructed in c++11 & copy constructed in c++98.
+
+template <class Alloc, class T>
+void relocate_range(Alloc &alloc, T *first, T *last, T *dest, ft::true_type) {
+    (void)alloc;
+    if (first != last) std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), (last - first) * sizeof(T));
+}
+
+template <class Alloc, class T>
+void relocate_range(Alloc &alloc, T *first, T *last, T *dest, ft::false_type) {
+    if (dest == first) return;
+
+    if (dest < first) {
+        for (; first != last; ++first, ++dest) {
+            alloc.construct(dest, FT_MOVE(*first));
+            alloc.destroy(first);
+        }
+    } else {
+        dest += last - first;
+        while (last != first) {
+            --last, --dest;
+            alloc.construct(dest, FT_MOVE(*last));
+            alloc.destroy(last);
+        }
+    }
+}
+
+template <class Alloc, class T>
+void relocate_range(Alloc &alloc, T *first, T *last, T *dest) {
+    ft::relocate_range(alloc, first, last, dest, ft::is_trivially_relocatable<T>());
+}
+
+}  // namespace ft
+
+#endif
@@ -25,6 +25,11 @@ class reverse_iterator {
 
     reverse_iterator(const reverse_iterator<Iterator> &rev_it) : current(rev_it.base()) {}
 
+    reverse_iterator &operator=(const reverse_iterator<Iterator> &rhs) {
+        this->current = rhs.base();
+        return *this;
+    }
+
     iterator_type base() const { return this->current; }
 
     reference operator*() const {
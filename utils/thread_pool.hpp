@@ -0,0 +1,128 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <pthread.h>
+#include <unistd.h>  // sysconf
+
+#include <cstddef>
+
+namespace ft {
+
+// thread_pool -> a fixed set of worker threads running fork-join tasks, for the parallel operations of the trees.
+// a task is forked (queued) then joined by the thread that forked it : while it waits, that thread runs the queued
+// tasks itself, so nested forks never block & a pool of a single thread runs everything in its caller.
+// the tasks live on the stack of the thread forking them, the pool doesn't allocate after its construction.
+// the operations given a pool go sequential on the pieces under its grain (in elements), where a task costs more
+// than it saves. like with std::thread, an exception escaping a task run by a worker terminates the program.
+
+class thread_pool {
+   public:
+    struct task {
+        void (*run)(task *);
+        task *next;
+        bool  done;
+
+        explicit task(void (*f)(task *)) : run(f), next(0), done(false) {}
+    };
+
+    // `threads` counts the caller, 0 for one thread per processor
+    explicit thread_pool(size_t threads = 0, size_t grain = 4096) : _queue(0), _stop(false), _grain(grain ? grain : 1), _workers(0), _count(0) {
+        if (!threads) threads = processors();
+        pthread_mutex_init(&this->_mutex, 0);
+        pthread_cond_init(&this->_cond, 0);
+        if (threads > 1) this->_workers = new pthread_t[threads - 1];
+        while (this->_count < threads - 1 && !pthread_create(&this->_workers[this->_count], 0, work, this)) this->_count++;
+    }
+
+    ~thread_pool() {
+        pthread_mutex_lock(&this->_mutex);
+        this->_stop = true;
+        pthread_cond_broadcast(&this->_cond);
+        pthread_mutex_unlock(&this->_mutex);
+        for (size_t i = 0; i < this->_count; i++) pthread_join(this->_workers[i], 0);
+        delete[] this->_workers;
+        pthread_cond_destroy(&this->_cond);
+        pthread_mutex_destroy(&this->_mutex);
+    }
+
+    size_t size() const { return this->_count + 1; }
+    size_t grain() const { return this->_grain; }
+
+    static size_t processors() {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+
+        return n > 0 ? n : 1;
+    }
+
+    // t may run on any thread of the pool from now on, until join(t)
+    void fork(task &t) {
+        t.done = false;
+        if (!this->_count) return this->execute(t);
+        pthread_mutex_lock(&this->_mutex);
+        t.next = this->_queue;
+        this->_queue = &t;
+        pthread_cond_signal(&this->_cond);
+        pthread_mutex_unlock(&this->_mutex);
+    }
+
+    // back once t has run, the queued tasks (the last forked first, often t itself) are run meanwhile
+    void join(task &t) {
+        pthread_mutex_lock(&this->_mutex);
+        while (!t.done) {
+            if (this->_queue)
+                this->runNext();
+            else
+                pthread_cond_wait(&this->_cond, &this->_mutex);
+        }
+        pthread_mutex_unlock(&this->_mutex);
+    }
+
+   private:
+    thread_pool(const thread_pool &);
+    thread_pool &operator=(const thread_pool &);
+
+    void execute(task &t) {
+        t.run(&t);
+        t.done = true;
+    }
+
+    // with the mutex, which is released while the task runs
+    void runNext() {
+        task *t = this->_queue;
+
+        this->_queue = t->next;
+        pthread_mutex_unlock(&this->_mutex);
+        t->run(t);
+        pthread_mutex_lock(&this->_mutex);
+        t->done = true;
+        pthread_cond_broadcast(&this->_cond);
+    }
+
+    static void *work(void *arg) {
+        thread_pool *p = static_cast<thread_pool *>(arg);
+
+        pthread_mutex_lock(&p->_mutex);
+        while (true) {
+            if (p->_queue)
+                p->runNext();
+            else if (p->_stop)
+                break;
+            else
+                pthread_cond_wait(&p->_cond, &p->_mutex);
+        }
+        pthread_mutex_unlock(&p->_mutex);
+        return 0;
+    }
+
+    pthread_mutex_t _mutex;
+    pthread_cond_t  _cond;
+    task           *_queue;  // the forked tasks not started yet, the last one on top
+    bool            _stop;
+    size_t          _grain;
+    pthread_t      *_workers;
+    size_t          _count;  // of workers
+};
+
+}  // namespace ft
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef __TYPE_TRAITS_HPP__
 #define __TYPE_TRAITS_HPP__
 
-#include <cstdint>
+#include "move.hpp"
 
 namespace ft {
 
@@ -29,6 +29,26 @@ struct integral_constant {
 typedef integral_constant<bool, true>  true_type;
 typedef integral_constant<bool, false> false_type;
 
+// is_same -> Trait class that identifies whether T & U are the same type.
+
+template <class T, class U>
+struct is_same : public false_type {};
+
+template <class T>
+struct is_same<T, T> : public true_type {};
+
+// conditional -> picks T when the condition is true & F otherwise.
+
+template <bool B, class T, class F>
+struct conditional {
+    typedef T type;
+};
+
+template <class T, class F>
+struct conditional<false, T, F> {
+    typedef F type;
+};
+
 // is_integral -> Trait class that identifies whether T is an integral type.
 
 template <class T>
@@ -40,11 +60,13 @@ struct is_integral<bool> : public true_type {};
 template <>
 struct is_integral<char> : public true_type {};
 
+#if FT_CXX11
 template <>
 struct is_integral<char16_t> : public true_type {};
 
 template <>
 struct is_integral<char32_t> : public true_type {};
+#endif
 
 template <>
 struct is_integral<wchar_t> : public true_type {};
@@ -79,6 +101,27 @@ struct is_integral<unsigned long int> : public true_type {};
 template <>
 struct is_integral<unsigned long long int> : public true_type {};
 
+// is_trivially_copyable -> Trait class that identifies whether T can be copied with a plain memcpy.
+// there is no way to detect this in c++98, so we rely on the compiler builtin (gcc & clang expose it in every mode).
+
+template <class T>
+struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+
+// is_trivially_destructible -> Trait class that identifies whether destroying a T does nothing, so the destructor call can be skipped.
+// same as above, the compiler builtin is the only way in c++98.
+
+template <class T>
+struct is_trivially_destructible : public integral_constant<bool, __has_trivial_destructor(T)> {};
+
+// is_trivially_relocatable -> Trait class that identifies whether an object of type T can be moved to a new address
+// with a memcpy/memmove, leaving the old storage raw (no destructor call on it).
+// every trivially copyable type qualifies, other types may opt in by specializing the trait, ex:
+//   template <> struct ft::is_trivially_relocatable<MyType> : public ft::true_type {};
+// a type must NOT opt in if it keeps a pointer to itself or one of its members (like a libstdc++ std::string).
+
+template <class T>
+struct is_trivially_relocatable : public integral_constant<bool, is_trivially_copyable<T>::value> {};
+
 };  // namespace ft
 
 #endif
\ No newline at end of file
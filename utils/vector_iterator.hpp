@@ -2,6 +2,7 @@
 #define __VECTOR_ITERATOR_HPP__
 
 #include "iterator.hpp"
+#include "move.hpp"
 
 namespace ft {
 
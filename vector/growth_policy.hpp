@@ -0,0 +1,66 @@
+#ifndef __GROWTH_POLICY_HPP__
+#define __GROWTH_POLICY_HPP__
+
+#include <cstddef>
+
+// growth policies of the contiguous containers.
+// a policy only decides the capacity to allocate when `required` elements don't fit in `capacity` anymore,
+// the container clamps the result between `required` & max_size().
+
+namespace ft {
+
+// capacity * 2 (the historical behavior, same sequence as the std containers)
+struct doubling_growth {
+  static size_t next_capacity(size_t capacity, size_t required, size_t value_size) {
+    (void)value_size;
+    return capacity * 2 > required ? capacity * 2 : required;
+  }
+};
+
+// capacity * 1.5, lets the allocator reuse the blocks freed by the previous growths
+struct one_and_half_growth {
+  static size_t next_capacity(size_t capacity, size_t required, size_t value_size) {
+    (void)value_size;
+    size_t next = capacity + capacity / 2;
+    return next > required ? next : required;
+  }
+};
+
+// capacity * 2 rounded up to a whole number of pages, so no byte of the last page is wasted
+template <size_t PageSize = 4096>
+struct page_growth {
+  static size_t next_capacity(size_t capacity, size_t required, size_t value_size) {
+    size_t next = doubling_growth::next_capacity(capacity, required, value_size);
+    size_t bytes = (next * value_size + PageSize - 1) / PageSize * PageSize;
+    return bytes / value_size;
+  }
+};
+
+// capacity + Increment, for memory bound workloads that grow slowly (quadratic copies on fast growth !)
+template <size_t Increment = 64>
+struct fixed_growth {
+  static size_t next_capacity(size_t capacity, size_t required, size_t value_size) {
+    (void)value_size;
+    size_t next = capacity + Increment;
+    return next > required ? next : required;
+  }
+};
+
+// capacity * 2, rounded up to a 2 MiB multiple once the buffer reaches Threshold bytes,
+// so big buffers map cleanly on transparent huge pages
+template <size_t Threshold = 2097152>
+struct huge_page_growth {
+  static const size_t huge_page_size = 2097152;
+
+  static size_t next_capacity(size_t capacity, size_t required, size_t value_size) {
+    size_t next = doubling_growth::next_capacity(capacity, required, value_size);
+    size_t bytes = next * value_size;
+
+    if (bytes < Threshold) return next;
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size / value_size;
+  }
+};
+
+}  // namespace ft
+
+#endif
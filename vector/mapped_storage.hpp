@@ -0,0 +1,62 @@
+#ifndef __MAPPED_STORAGE_HPP__
+#define __MAPPED_STORAGE_HPP__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "type_traits.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define FT_HAS_MREMAP 1
+#else
+#define FT_HAS_MREMAP 0
+#endif
+
+// buffers of at least FT_MREMAP_THRESHOLD bytes are mapped directly with mmap, so a growth is an mremap :
+// the kernel moves the page table entries instead of copying the elements.
+#ifndef FT_MREMAP_THRESHOLD
+#define FT_MREMAP_THRESHOLD (1 << 20)
+#endif
+
+namespace ft {
+
+template <class T, class Alloc>
+struct mapped_storage {
+  // only for elements movable with a memcpy & when the memory is ours (custom allocators keep their path)
+  static const bool enabled = FT_HAS_MREMAP && ft::is_trivially_relocatable<T>::value && ft::is_same<Alloc, std::allocator<T> >::value;
+
+  static bool is_mapped(size_t capacity) { return enabled && capacity * sizeof(T) >= FT_MREMAP_THRESHOLD; }
+
+#if FT_HAS_MREMAP
+  static size_t mapping_size(size_t capacity) {
+    size_t page = getpagesize();
+    return (capacity * sizeof(T) + page - 1) / page * page;
+  }
+
+  static T *allocate(size_t capacity) {
+    void *ptr = mmap(NULL, mapping_size(capacity), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  static T *reallocate(T *ptr, size_t capacity, size_t new_capacity) {
+    void *new_ptr = mremap(ptr, mapping_size(capacity), mapping_size(new_capacity), MREMAP_MAYMOVE);
+    if (new_ptr == MAP_FAILED) throw std::bad_alloc();
+    return static_cast<T *>(new_ptr);
+  }
+
+  static void deallocate(T *ptr, size_t capacity) { munmap(ptr, mapping_size(capacity)); }
+#else
+  // never called, is_mapped() is always false without mremap
+  static T   *allocate(size_t capacity) { (void)capacity; throw std::bad_alloc(); }
+  static T   *reallocate(T *ptr, size_t capacity, size_t new_capacity) { (void)ptr, (void)capacity, (void)new_capacity; throw std::bad_alloc(); }
+  static void deallocate(T *ptr, size_t capacity) { (void)ptr, (void)capacity; }
+#endif
+};
+
+}  // namespace ft
+
+#endif
@@ -0,0 +1,411 @@
+#ifndef __SMALL_VECTOR_HPP__
+#define __SMALL_VECTOR_HPP__
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "equal.hpp"
+#include "growth_policy.hpp"
+#include "iterator.hpp"
+#include "lexicographical_compare.hpp"
+#include "move.hpp"
+#include "relocate.hpp"
+#include "reverse_iterator.hpp"
+#include "type_traits.hpp"
+#include "vector_iterator.hpp"
+
+namespace ft {
+
+// small_vector -> same interface as ft::vector, but the first N elements live inside the object itself,
+// the heap is only used once the vector outgrows its inline storage.
+template <class T, size_t N, class Alloc = std::allocator<T>, class Growth = ft::doubling_growth>
+class small_vector {
+ public:
+  // member types
+  typedef T                                                       value_type;
+  typedef Alloc                                                   allocator_type;
+  typedef Growth                                                  growth_policy;
+  typedef typename allocator_type::reference                      reference;
+  typedef typename allocator_type::const_reference                const_reference;
+  typedef typename allocator_type::pointer                        pointer;
+  typedef typename allocator_type::const_pointer                  const_pointer;
+  typedef typename allocator_type::size_type                      size_type;
+  typedef ft::vector_iterator<value_type>                         iterator;
+  typedef ft::vector_iterator<const value_type>                   const_iterator;
+  typedef ft::reverse_iterator<iterator>                          reverse_iterator;
+  typedef ft::reverse_iterator<const_iterator>                    const_reverse_iterator;
+  typedef typename ft::iterator_traits<iterator>::difference_type difference_type;
+
+  static const size_type inline_capacity = N;
+
+ private:
+  typedef char inline_capacity_must_not_be_zero[N ? 1 : -1];
+
+  pointer        arr;
+  allocator_type alloc;
+  size_type      cap;
+  size_type      _size;
+  char           storage[sizeof(T) * N] __attribute__((aligned(__alignof__(T))));
+
+  void init(const allocator_type& alloc) {
+    this->alloc = alloc;
+    this->arr = this->inline_storage();
+    this->cap = N;
+    this->_size = 0;
+  }
+
+  pointer inline_storage(void) { return reinterpret_cast<pointer>(this->storage); }
+
+  size_type next_capacity(size_type required) const {
+    if (required > this->max_size()) throw std::length_error("small_vector");
+
+    size_type next = growth_policy::next_capacity(this->capacity(), required, sizeof(value_type));
+    return std::min(std::max(next, required), this->max_size());
+  }
+
+  void grow(size_type required) {
+    if (required > this->capacity()) this->extend(this->next_capacity(required));
+  }
+
+  void extend(size_type new_cap, bool do_copy = true) {
+    pointer   tmp_arr = this->arr;
+    size_type tmp_cap = this->capacity();
+
+    this->arr = this->alloc.allocate(new_cap);
+    this->cap = new_cap;
+    if (do_copy)
+      ft::relocate_range(this->alloc, tmp_arr, tmp_arr + this->size(), this->arr);
+    else
+      ft::destroy_range(this->alloc, tmp_arr, tmp_arr + this->size());
+    if (tmp_arr != this->inline_storage()) this->alloc.deallocate(tmp_arr, tmp_cap);
+  }
+
+  // move the content of `x` into this empty vector, `x` is left empty on its inline storage
+  void take(small_vector& x) {
+    if (!x.is_inline()) {
+      if (!this->is_inline()) this->alloc.deallocate(this->arr, this->capacity());
+      this->arr = x.arr;
+      this->cap = x.cap;
+      x.arr = x.inline_storage();
+      x.cap = N;
+    } else {
+      this->reserve(x.size());
+      ft::relocate_range(this->alloc, x.arr, x.arr + x.size(), this->arr);
+    }
+    this->_size = x._size;
+    x._size = 0;
+  }
+
+ public:
+  // constructors of small_vector
+  explicit small_vector(const allocator_type& alloc = allocator_type()) { this->init(alloc); }
+
+  explicit small_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type()) {
+    this->init(alloc);
+    this->assign(n, val);
+  }
+
+  template <class InputIterator>
+  small_vector(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last, const allocator_type& alloc = allocator_type()) {
+    this->init(alloc);
+    this->assign(first, last);
+  }
+
+  // copy constructor
+  small_vector(const small_vector& x) {
+    this->init(x.get_allocator());
+    this->reserve(x.size());
+    ft::construct_range(this->alloc, x.arr, x.arr + x.size(), this->arr);
+    this->_size = x.size();
+  }
+
+#if FT_CXX11
+  // move constructor, steals the heap buffer or relocates the inline elements
+  small_vector(small_vector&& x) {
+    this->init(x.get_allocator());
+    this->take(x);
+  }
+
+  // move assignment operator
+  small_vector& operator=(small_vector&& x) {
+    if (this != &x) {
+      this->clear();
+      this->take(x);
+    }
+    return *this;
+  }
+#endif
+
+  // copy assignment operator
+  small_vector& operator=(const small_vector& x) {
+    if (this != &x) {
+      if (x.size() > this->capacity()) {
+        this->extend(x.size(), false);
+        this->_size = 0;
+      }
+
+      size_type common = std::min(this->size(), x.size());
+      ft::assign_range(x.arr, x.arr + common, this->arr);
+      ft::construct_range(this->alloc, x.arr + common, x.arr + x.size(), this->arr + common);
+      if (this->size() > x.size()) ft::destroy_range(this->alloc, this->arr + x.size(), this->arr + this->size());
+      this->_size = x.size();
+    }
+    return *this;
+  }
+
+  // -------------------------------- Iterator function -------------------------------
+
+  iterator       begin() { return iterator(this->arr); }
+  const_iterator begin() const { return const_iterator(this->arr); }
+
+  iterator       end() { return iterator(this->arr + this->size()); }
+  const_iterator end() const { return const_iterator(this->arr + this->size()); }
+
+  reverse_iterator       rbegin() { return reverse_iterator(this->end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+  reverse_iterator       rend() { return reverse_iterator(this->begin()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+  // --------------------------------  End of iterator function ------------------------
+
+  // -------------------------------- Capacity functions -----------------------------
+
+  size_type capacity() const { return this->cap; }
+  size_type size() const { return this->_size; }
+  size_type max_size() const { return this->alloc.max_size(); }
+  bool      empty() const { return !this->size(); }
+  bool      is_inline() const { return this->arr == reinterpret_cast<const_pointer>(this->storage); }
+
+  void resize(size_type n, value_type val = value_type()) {
+    if (n > this->max_size()) throw std::length_error("small_vector");
+
+    if (n < this->size()) {
+      ft::destroy_range(this->alloc, this->arr + n, this->arr + this->size());
+    } else {
+      this->grow(n);
+      for (; this->_size < n; this->_size++) this->alloc.construct(this->arr + this->_size, val);
+    }
+    this->_size = n;
+  }
+
+  void reserve(size_type n) {
+    if (n > this->max_size()) throw std::length_error("small_vector");
+
+    if (n > this->capacity()) this->extend(n);
+  }
+
+  // -------------------------------- End of capacity functions -----------------------------
+
+  // -------------------------------- Element access functions ------------------------------
+
+  reference       operator[](size_type n) { return this->arr[n]; }
+  const_reference operator[](size_type n) const { return this->arr[n]; }
+
+  reference at(size_type n) {
+    if (n >= this->size()) throw std::out_of_range("small_vector");
+    return this->arr[n];
+  }
+  const_reference at(size_type n) const {
+    if (n >= this->size()) throw std::out_of_range("small_vector");
+    return this->arr[n];
+  }
+
+  reference       front() { return this->arr[0]; }
+  const_reference front() const { return this->arr[0]; }
+
+  reference       back() { return this->arr[this->size() - 1]; }
+  const_reference back() const { return this->arr[this->size() - 1]; }
+
+  // -------------------------------- End of element access functions -----------------------
+
+  // -------------------------------- Modifiers function -----------------------------------
+
+  template <class InputIterator>
+  void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last) {
+    difference_type diff = ft::_distance(first, last);
+    if (diff < 0 || (size_type)diff > this->max_size()) throw std::length_error("small_vector");
+
+    if ((size_type)diff > this->capacity()) {
+      this->extend(diff, false);
+      this->_size = 0;
+    }
+
+    size_type idx = 0;
+    for (; idx < this->size() && first != last; idx++, first++) this->arr[idx] = *first;
+    for (; first != last; idx++, first++) this->alloc.construct(this->arr + idx, *first);
+    if (this->size() > idx) ft::destroy_range(this->alloc, this->arr + idx, this->arr + this->size());
+    this->_size = idx;
+  }
+
+  void assign(size_type n, const value_type& val) {
+    if (n > this->max_size()) throw std::length_error("small_vector");
+
+    if (n > this->capacity()) {
+      this->extend(n, false);
+      this->_size = 0;
+    }
+
+    size_type idx = 0;
+    for (; idx < this->size() && idx < n; idx++) this->arr[idx] = val;
+    for (; idx < n; idx++) this->alloc.construct(this->arr + idx, val);
+    if (this->size() > n) ft::destroy_range(this->alloc, this->arr + n, this->arr + this->size());
+    this->_size = n;
+  }
+
+  void push_back(const value_type& val) {
+    if (this->size() == this->capacity()) {
+      value_type copy(val);  // `val` may be one of our elements, relocated by the growth
+
+      this->grow(this->size() + 1);
+      this->alloc.construct(this->arr + this->_size++, FT_MOVE(copy));
+      return;
+    }
+    this->alloc.construct(this->arr + this->_size++, val);
+  }
+
+  void pop_back() { this->alloc.destroy(this->arr + --this->_size); }
+
+#if FT_CXX11
+  void push_back(value_type&& val) { this->emplace_back(std::move(val)); }
+
+  template <class... Args>
+  void emplace_back(Args&&... args) {
+    if (this->size() == this->capacity()) {
+      value_type tmp(std::forward<Args>(args)...);  // built before the growth, `args` may refer to our elements
+
+      this->grow(this->size() + 1);
+      this->alloc.construct(this->arr + this->_size, std::move(tmp));
+      this->_size++;
+      return;
+    }
+    this->alloc.construct(this->arr + this->_size, std::forward<Args>(args)...);
+    this->_size++;
+  }
+
+  iterator insert(iterator const& position, value_type&& val) { return this->emplace(position, std::move(val)); }
+
+  template <class... Args>
+  iterator emplace(iterator const& position, Args&&... args) {
+    difference_type diff = position - this->begin();
+    value_type      tmp(std::forward<Args>(args)...);  // built before the relocation, `args` may refer to our elements
+
+    this->grow(this->size() + 1);
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + 1);
+    this->alloc.construct(this->arr + diff, std::move(tmp));
+    this->_size++;
+    return this->begin() + diff;
+  }
+#endif
+
+  iterator insert(iterator const& position, const value_type& val) {
+    difference_type diff = position - this->begin();
+
+    this->insert(position, (size_type)1, val);
+    return this->begin() + diff;
+  }
+
+  void insert(iterator position, size_type n, const value_type& val) {
+    difference_type diff = position - this->begin();
+    value_type      copy(val);  // `val` may live in the part of the buffer that gets relocated
+
+    this->grow(this->size() + n);
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + n);
+    for (size_type idx = 0; idx < n; idx++) this->alloc.construct(this->arr + diff + idx, copy);
+    this->_size += n;
+  }
+
+  template <class InputIterator>
+  void insert(iterator position, typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last) {
+    difference_type diff = position - this->begin();
+    small_vector    tmp(first, last);
+    size_type       n = tmp.size();
+
+    this->grow(this->size() + n);
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + n);
+    ft::relocate_range(this->alloc, tmp.arr, tmp.arr + n, this->arr + diff);
+    tmp._size = 0;
+    this->_size += n;
+  }
+
+  iterator erase(iterator position) { return this->erase(position, position + 1); }
+
+  iterator erase(iterator first, iterator last) {
+    difference_type diff = first - this->begin();
+    difference_type n = last - first;
+
+    ft::destroy_range(this->alloc, this->arr + diff, this->arr + diff + n);
+    ft::relocate_range(this->alloc, this->arr + diff + n, this->arr + this->size(), this->arr + diff);
+    this->_size -= n;
+    return this->begin() + diff;
+  }
+
+  void swap(small_vector& x) {
+    if (!this->is_inline() && !x.is_inline()) {
+      std::swap(this->arr, x.arr);
+      std::swap(this->cap, x.cap);
+      std::swap(this->_size, x._size);
+      return;
+    }
+
+    // at least one side is inline, the elements have to be relocated
+    small_vector tmp;
+    tmp.take(*this);
+    this->take(x);
+    x.take(tmp);
+  }
+
+  void clear() { this->erase(this->begin(), this->end()); }
+
+  // -------------------------------- End of modifiers functions ----------------------------
+
+  // allocator functions
+  allocator_type get_allocator() const { return this->alloc; }
+
+  // destructor
+  ~small_vector() {
+    ft::destroy_range(this->alloc, this->arr, this->arr + this->size());
+    if (!this->is_inline()) this->alloc.deallocate(this->arr, this->capacity());
+  }
+};
+
+// relational operators
+template <class T, size_t N, class Alloc, class Growth>
+bool operator==(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+bool operator!=(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+bool operator<(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+bool operator<=(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(rhs < lhs);
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+bool operator>(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return rhs < lhs;
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+bool operator>=(const small_vector<T, N, Alloc, Growth>& lhs, const small_vector<T, N, Alloc, Growth>& rhs) {
+  return !(lhs < rhs);
+}
+
+template <class T, size_t N, class Alloc, class Growth>
+void swap(small_vector<T, N, Alloc, Growth>& x, small_vector<T, N, Alloc, Growth>& y) {
+  x.swap(y);
+}
+
+}  // namespace ft
+
+#endif
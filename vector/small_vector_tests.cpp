@@ -0,0 +1,124 @@
+#include "tests.hpp"
+
+// std has no small_vector, the std build runs the same scenarios on std::vector
+#if STD
+template <class T, size_t N>
+struct small_vector_of {
+    typedef std::vector<T> type;
+};
+#else
+template <class T, size_t N>
+struct small_vector_of {
+    typedef ft::small_vector<T, N> type;
+};
+#endif
+
+typedef small_vector_of<int, 4>::type         small_ints;
+typedef small_vector_of<std::string, 4>::type small_strings;
+
+template <class Vector>
+static void print(const char *name, const Vector &vec) {
+    std::cout << name << " contains:";
+    for (typename Vector::const_iterator it = vec.begin(); it != vec.end(); ++it) std::cout << ' ' << *it;
+    std::cout << '\n';
+}
+
+static void test_inline_to_heap(void) {
+    small_ints vec;
+
+    for (int i = 1; i <= 3; i++) vec.push_back(i * 10);
+    print("vec", vec);
+    for (int i = 4; i <= 9; i++) vec.push_back(i * 10);  // spills on the heap
+    print("vec", vec);
+    vec.resize(2);
+    print("vec", vec);
+    std::cout << "size: " << vec.size() << '\n';
+}
+
+static void test_insert_erase(void) {
+    small_strings words(2, "two");
+
+    words.insert(words.begin(), "first");
+    words.insert(words.begin() + 1, 3, "three");
+    small_strings more(2, "more");
+    words.insert(words.end(), more.begin(), more.end());
+    print("words", words);
+
+    words.erase(words.begin() + 1, words.begin() + 4);
+    words.erase(words.begin());
+    words.pop_back();
+    print("words", words);
+}
+
+// the pushed element is one of the vector's own, at the spill from the inline storage to the heap
+static void test_self_push_back(void) {
+    small_vector_of<std::string, 1>::type words;
+
+    words.push_back("self");
+    words.push_back(words[0]);
+    for (int i = 0; i < 6; i++) words.push_back(words.back());
+    print("words", words);
+}
+
+static void test_copy_assign_swap(void) {
+    small_strings inline_words(3, "in");
+    small_strings heap_words(10, "heap");
+
+    small_strings copy(heap_words);
+    copy = inline_words;
+    print("copy", copy);
+
+    inline_words.swap(heap_words);
+    print("inline_words", inline_words);
+    print("heap_words", heap_words);
+
+    small_strings other(2, "other");
+    other.swap(heap_words);  // both inline
+    print("other", other);
+    print("heap_words", heap_words);
+
+    small_ints a(8, 1), b(8, 2);
+    a.swap(b);  // both on the heap
+    std::cout << "a == b: " << (a == b) << ", a > b: " << (a > b) << '\n';
+}
+
+static void test_assign(void) {
+    small_ints vec(6, 7);
+
+    vec.assign(2, 3);
+    print("vec", vec);
+
+    int values[] = {5, 4, 3, 2, 1, 0};
+    vec.assign(values, values + 6);
+    print("vec", vec);
+    vec.clear();
+    std::cout << "empty: " << vec.empty() << '\n';
+}
+
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+    small_strings words(3, "in");
+
+    words.emplace(words.begin() + 1, 3, 'x');
+    words.insert(words.begin(), std::string("first"));  // spills on the heap
+    words.emplace(words.end(), words[0]);
+    words.emplace_back(2, 'y');
+    print("words", words);
+
+    small_vector_of<std::string, 1>::type self(1, "self");
+    self.emplace_back(self[0]);  // spills : the argument is the inline element the growth relocates
+    self.emplace_back(self.back(), 0, 2);
+    print("self", self);
+}
+#endif
+
+void small_vector_main(void) {
+    start_test("Test inline to heap", test_inline_to_heap);
+    start_test("Test insert, erase", test_insert_erase);
+    start_test("Test copy, assign, swap", test_copy_assign_swap);
+    start_test("Test assign", test_assign);
+    start_test("Test self push_back", test_self_push_back);
+#if __cplusplus >= 201103L
+    start_test("Test move semantics", test_move_semantics);
+#endif
+}
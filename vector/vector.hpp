@@ -5,20 +5,25 @@
 #include <memory>
 
 #include "equal.hpp"
+#include "growth_policy.hpp"
 #include "iterator.hpp"
 #include "lexicographical_compare.hpp"
+#include "mapped_storage.hpp"
+#include "move.hpp"
+#include "relocate.hpp"
 #include "reverse_iterator.hpp"
 #include "type_traits.hpp"
 #include "vector_iterator.hpp"
 
 namespace ft {
 
-template <class T, class Alloc = std::allocator<T> >
+template <class T, class Alloc = std::allocator<T>, class Growth = ft::doubling_growth>
 class vector {
  public:
   // member types
   typedef T                                                       value_type;
   typedef Alloc                                                   allocator_type;
+  typedef Growth                                                  growth_policy;
   typedef typename allocator_type::reference                      reference;
   typedef typename allocator_type::const_reference                const_reference;
   typedef typename allocator_type::pointer                        pointer;
@@ -31,6 +36,8 @@ class vector {
   typedef typename ft::iterator_traits<iterator>::difference_type difference_type;
 
  private:
+  typedef ft::mapped_storage<value_type, allocator_type> mapped_storage;
+
   pointer        arr;
   allocator_type alloc;
   size_type      cap;
@@ -42,15 +49,48 @@ class vector {
     this->_size = _size;
   }
 
+  // the capacity to use when `required` elements don't fit anymore, picked by the growth policy
+  size_type next_capacity(size_type required) const {
+    if (required > this->max_size()) throw std::length_error("vector");
+
+    size_type next = growth_policy::next_capacity(this->capacity(), required, sizeof(value_type));
+    return std::min(std::max(next, required), this->max_size());
+  }
+
+  void grow(size_type required) {
+    if (required > this->capacity()) this->extend(this->next_capacity(required));
+  }
+
+  // big buffers of trivially relocatable elements are mapped (see mapped_storage.hpp), the others come from the allocator
+  pointer allocate(size_type n) {
+    if (mapped_storage::is_mapped(n)) return mapped_storage::allocate(n);
+    return this->alloc.allocate(n);
+  }
+
+  void deallocate(pointer p, size_type n) {
+    if (mapped_storage::is_mapped(n))
+      mapped_storage::deallocate(p, n);
+    else
+      this->alloc.deallocate(p, n);
+  }
+
   void extend(size_type new_cap, bool do_copy = true) {
     size_type tmp_cap = this->capacity();
     pointer   tmp_arr = this->arr;
 
     this->cap = new_cap;
-    this->arr = this->alloc.allocate(this->capacity());
-    if (do_copy) std::memcpy(this->arr, tmp_arr, this->size() * sizeof(value_type));
-    for (size_type idx = 0; idx < this->size(); idx++) this->alloc.destroy(tmp_arr + idx);
-    this->alloc.deallocate(tmp_arr, tmp_cap);
+    if (do_copy && mapped_storage::is_mapped(tmp_cap)) {
+      // grow the mapping, the pages are moved & not copied
+      this->arr = mapped_storage::reallocate(tmp_arr, tmp_cap, new_cap);
+      return;
+    }
+
+    this->arr = this->allocate(this->capacity());
+    if (do_copy)
+      ft::relocate_range(this->alloc, tmp_arr, tmp_arr + this->size(), this->arr);
+    else
+      ft::destroy_range(this->alloc, tmp_arr, tmp_arr + this->size());
+    this->deallocate(tmp_arr, tmp_cap);
   }
 
  public:
@@ -63,7 +103,7 @@ class vector {
     if (n > this->max_size()) throw std::length_error("vector");
 
     this->init(n, 0, alloc);
-    this->arr = this->alloc.allocate(n);
+    this->arr = this->allocate(n);
     for (size_type i = 0; i < n; i++, this->_size++) {
       this->alloc.construct(this->arr + i, val);
     }
@@ -76,7 +116,7 @@ class vector {
     if (diff < 0 || (size_type)diff > this->max_size()) throw std::length_error("vector");
 
     this->init(diff, diff, alloc);
-    this->arr = this->alloc.allocate(diff);
+    this->arr = this->allocate(diff);
 
     size_type idx = 0;
     while (first != last) {
@@ -88,17 +128,42 @@ class vector {
   // copy constructor
   vector(const vector& x) {
     this->init(x.size(), x.size(), x.get_allocator());
-    this->arr = this->alloc.allocate(this->capacity());
+    this->arr = this->capacity() ? this->allocate(this->capacity()) : nullptr;
 
     // copy `arr` of x to `this->arr`
-    std::memcpy(this->arr, x.arr, this->size() * sizeof(value_type));
+    ft::construct_range(this->alloc, x.arr, x.arr + x.size(), this->arr);
+  }
+#if FT_CXX11
+  // move constructor
+  vector(vector&& x) : arr(x.arr), alloc(x.alloc), cap(x.cap), _size(x._size) {
+    x.arr = nullptr;
+    x.cap = 0;
+    x._size = 0;
   }
+
+  // move assignment operator
+  vector& operator=(vector&& x) {
+    vector tmp(std::move(x));
+
+    this->swap(tmp);
+    return *this;
+  }
+#endif
+
   // copy assignment operator
   vector& operator=(const vector& x) {
     if (this != &x) {
-      if (x.size() > this->capacity()) this->extend(x.size(), false);
+      if (x.size() > this->capacity()) {
+        this->extend(x.size(), false);
+        this->_size = 0;
+      }
+
+      // assign over the live elements, construct the missing ones & destroy the extra ones
+      size_type common = std::min(this->size(), x.size());
+      ft::assign_range(x.arr, x.arr + common, this->arr);
+      ft::construct_range(this->alloc, x.arr + common, x.arr + x.size(), this->arr + common);
+      if (this->size() > x.size()) ft::destroy_range(this->alloc, this->arr + x.size(), this->arr + this->size());
       this->_size = x.size();
-      std::memmove(this->arr, x.arr, x.size() * sizeof(value_type));
     }
 
     return *this;
@@ -134,9 +199,7 @@ class vector {
       size_type idx = n;
       for (; idx < this->size(); idx++) this->alloc.destroy(this->arr + idx);
     } else {
-      if (n > this->capacity()) {
-        this->extend(std::max<size_type>(n, this->capacity() * 2));
-      }
+      this->grow(n);
 
       for (; this->_size < n; this->_size++) this->alloc.construct(this->arr + this->_size, val);
     }
@@ -175,75 +238,64 @@ class vector {
 
   // -------------------------------- Modifiers function -----------------------------------
 
+  // like the copy assignment : assign over the live elements, construct the missing ones & destroy the extra ones
   template <class InputIterator>
   void assign(typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type first, InputIterator last) {
     difference_type diff = ft::_distance(first, last);
     if (diff < 0 || (size_type)diff > this->max_size()) throw std::length_error("vector");
 
-    bool do_construct = false;
     if ((size_type)diff > this->capacity()) {
       this->extend(diff, false);
-      do_construct = true;
       this->_size = 0;
     }
     size_type idx = 0;
-    for (; idx < (size_type)diff && first != last; idx++, first++) {
-      if (do_construct)
-        this->alloc.construct(this->arr + idx, *first);
-      else
-        this->arr[idx] = *first;
-    }
-    for (; idx < this->size(); idx++) this->alloc.destroy(this->arr + idx);
-    this->_size = diff;
+    for (; idx < this->size() && first != last; idx++, first++) this->arr[idx] = *first;
+    for (; first != last; idx++, first++) this->alloc.construct(this->arr + idx, *first);
+    if (this->size() > idx) ft::destroy_range(this->alloc, this->arr + idx, this->arr + this->size());
+    this->_size = idx;
   }
 
   void assign(size_type n, const value_type& val) {
     if (n > this->max_size()) throw std::length_error("vector");
 
-    bool do_construct = false;
-
+    value_type copy(val);  // `val` may be one of the elements destroyed by the growth
     if (n > this->capacity()) {
       this->extend(n, false);
-      do_construct = true;
       this->_size = 0;
     }
 
     size_type idx = 0;
-    for (; idx < n; idx++) {
-      if (do_construct)
-        this->alloc.construct(this->arr + idx, val);
-      else
-        this->arr[idx] = val;
-    }
-    for (; idx < this->size(); idx++) this->alloc.destroy(this->arr + idx);
-
+    for (; idx < this->size() && idx < n; idx++) this->arr[idx] = copy;
+    for (; idx < n; idx++) this->alloc.construct(this->arr + idx, copy);
+    if (this->size() > n) ft::destroy_range(this->alloc, this->arr + n, this->arr + this->size());
     this->_size = n;
   }
 
   void push_back(const value_type& val) {
-    if (!this->capacity()) this->reserve(1);
-
-    if (this->size() == this->capacity()) this->extend(this->capacity() * 2);
+    if (this->size() == this->capacity()) {
+      value_type copy(val);  // `val` may be one of our elements, relocated by the growth
 
+      this->grow(this->size() + 1);
+      this->alloc.construct(this->arr + this->_size++, FT_MOVE(copy));
+      return;
+    }
     this->alloc.construct(this->arr + this->_size++, val);
   }
 
-  void pop_back() { this->alloc.destroy(this->arr + this->_size--); }  // CHECK : does linux implementation throw an error in case of empty vector!
+  void pop_back() { this->alloc.destroy(this->arr + --this->_size); }  // CHECK : does linux implementation throw an error in case of empty vector!
 
   iterator insert(iterator const& position, const value_type& val) {
     difference_type diff = position - this->begin();
+    value_type      copy(val);  // `val` may live in the part of the buffer that gets relocated
 
     if (!this->capacity()) {
       this->push_back(val);
       return this->begin();
     }
 
-    if (this->size() + 1 > this->max_size())
-      throw std::length_error("vector");
-    else if (this->size() + 1 > this->capacity())
-      this->reserve(this->capacity() * 2);
-    std::memmove(this->arr + diff + 1, this->arr + diff, (this->size() - diff) * sizeof(value_type));
-    this->arr[diff] = val;
+    this->grow(this->size() + 1);
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + 1);
+    this->alloc.construct(this->arr + diff, FT_MOVE(copy));
     this->_size++;
 
     return this->begin() + diff;
@@ -251,19 +303,15 @@ class vector {
 
   void insert(iterator position, size_type n, const value_type& val) {
     difference_type diff = position - this->begin();
+    value_type      copy(val);
 
-    if (!this->capacity()) this->reserve(n);
-
-    if (this->size() + n > this->max_size())
-      throw std::length_error("vector");
-    else if (this->size() + n > this->capacity())
-      this->reserve(this->size() + n);
+    this->grow(this->size() + n);
 
-    std::memmove(this->arr + diff + n, this->arr + diff, (this->size() - diff) * sizeof(value_type));
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + n);
 
     size_type idx = 0;
     while (idx < n) {
-      this->alloc.construct(this->arr + diff + idx, val);
+      this->alloc.construct(this->arr + diff + idx, copy);
       idx++;
     }
     this->_size += n;
@@ -278,22 +326,10 @@ class vector {
 
     vector<value_type> vec(first, last);
 
-    if (!this->capacity()) this->reserve(n);
-
-    if (this->size() + n > this->max_size())
-      throw std::length_error("vector");
-    else if (this->size() + n > this->capacity())
-      this->reserve(this->size() + n);
-
-    std::memmove(this->arr + diff + n, this->arr + diff, (this->size() - diff) * sizeof(value_type));
+    this->grow(this->size() + n);
 
-    size_type idx = 0;
-    iterator  it = vec.begin();
-    while (it != vec.end()) {
-      this->alloc.construct(this->arr + diff + idx, *it);
-      it++;
-      idx++;
-    }
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + n);
+    ft::construct_range(this->alloc, vec.begin().base(), vec.end().base(), this->arr + diff);
     this->_size += n;
   }
 
@@ -301,7 +337,7 @@ class vector {
     difference_type diff = position - this->begin();
 
     this->alloc.destroy(this->arr + diff);
-    std::memmove(this->arr + diff, this->arr + diff + 1, (this->size() - diff - 1) * sizeof(value_type));
+    ft::relocate_range(this->alloc, this->arr + diff + 1, this->arr + this->size(), this->arr + diff);
     this->_size--;
     return this->begin() + diff;
   }
@@ -310,18 +346,46 @@ class vector {
     difference_type diff = first - this->begin();
     difference_type n = last - first;
 
-    size_type idx = 0;
-    while (first < last) {
-      this->alloc.destroy(this->arr + n + idx);
-      first++;
-      idx++;
-    }
-    std::memmove(this->arr + diff, this->arr + diff + n, (this->size() - n - diff) * sizeof(value_type));
+    ft::destroy_range(this->alloc, this->arr + diff, this->arr + diff + n);
+    ft::relocate_range(this->alloc, this->arr + diff + n, this->arr + this->size(), this->arr + diff);
     this->_size -= n;
 
     return this->begin() + diff;
   }
 
+#if FT_CXX11
+  void push_back(value_type&& val) { this->emplace_back(std::move(val)); }
+
+  template <class... Args>
+  void emplace_back(Args&&... args) {
+    if (this->size() == this->capacity()) {
+      value_type tmp(std::forward<Args>(args)...);  // built before the growth, `args` may refer to our elements
+
+      this->grow(this->size() + 1);
+      this->alloc.construct(this->arr + this->_size, std::move(tmp));
+      this->_size++;
+      return;
+    }
+    this->alloc.construct(this->arr + this->_size, std::forward<Args>(args)...);
+    this->_size++;
+  }
+
+  iterator insert(iterator const& position, value_type&& val) { return this->emplace(position, std::move(val)); }
+
+  template <class... Args>
+  iterator emplace(iterator const& position, Args&&... args) {
+    difference_type diff = position - this->begin();
+    value_type      tmp(std::forward<Args>(args)...);  // built before the relocation, `args` may refer to our elements
+
+    this->grow(this->size() + 1);
+    ft::relocate_range(this->alloc, this->arr + diff, this->arr + this->size(), this->arr + diff + 1);
+    this->alloc.construct(this->arr + diff, std::move(tmp));
+    this->_size++;
+
+    return this->begin() + diff;
+  }
+#endif
+
   void swap(vector& x) {
     std::swap(this->cap, x.cap);
     std::swap(this->_size, x._size);
@@ -342,48 +406,52 @@ class vector {
       this->alloc.destroy(this->arr + idx);
     }
 
-    this->alloc.deallocate(this->arr, this->capacity());
+    this->deallocate(this->arr, this->capacity());
   }
 };
 
 // relational operators
-template <class T, class Alloc>
-bool operator==(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator==(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   if (lhs.size() == rhs.size()) {
     return ft::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
   return false;
 }
-template <class T, class Alloc>
-bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   return !(lhs == rhs);
 }
 
-template <class T, class Alloc>
-bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 }
 
-template <class T, class Alloc>
-bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   return !(rhs < lhs);
 }
 
-template <class T, class Alloc>
-bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   return rhs < lhs;
 }
 
-template <class T, class Alloc>
-bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs) {
+template <class T, class Alloc, class Growth>
+bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs) {
   return !(lhs < rhs);
 }
 
-template <class T, class Alloc>
-void swap(vector<T, Alloc>& x, vector<T, Alloc>& y) {
+template <class T, class Alloc, class Growth>
+void swap(vector<T, Alloc, Growth>& x, vector<T, Alloc, Growth>& y) {
   x.swap(y);
 }
 
+// a vector only holds a pointer to its buffer, so it can be relocated whatever its element type is
+template <class T, class Alloc, class Growth>
+struct is_trivially_relocatable<vector<T, Alloc, Growth> > : public true_type {};
+
 }  // namespace ft
 
 #endif
\ No newline at end of file
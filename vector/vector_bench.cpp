@@ -0,0 +1,198 @@
+#include <vector>
+
+#include "benchmarks.hpp"
+#include "small_vector.hpp"
+
+struct Blob {
+  char data[64];
+};
+
+// the element type of ft_container.cpp
+struct Buffer {
+  int  idx;
+  char buff[4096];
+};
+
+// same layout, but a user provided copy constructor makes it non trivial
+template <bool Relocatable>
+struct Handle {
+  int *ptr;
+
+  Handle() : ptr(NULL) {}
+  Handle(const Handle &copy) : ptr(copy.ptr) {}
+  Handle &operator=(const Handle &rhs) {
+    this->ptr = rhs.ptr;
+    return *this;
+  }
+  ~Handle() {}
+};
+
+namespace ft {
+template <>
+struct is_trivially_relocatable<Handle<true> > : public true_type {};
+}  // namespace ft
+
+template <class Vector>
+static void bench_growth(const std::string &label, const typename Vector::value_type &val) {
+  bench_timer timer;
+  {
+    Vector vec;
+    for (size_t i = 0; i < bench_count; i++) vec.push_back(val);
+    do_not_optimize(vec);
+  }
+  report(label, bench_count, timer.elapsed());
+}
+
+template <class Vector>
+static void bench_front_insert_erase(const std::string &label, const typename Vector::value_type &val) {
+  const size_t count = bench_count / 100;
+  Vector       vec(count, val);
+
+  bench_timer timer;
+  for (size_t i = 0; i < 1000; i++) vec.insert(vec.begin(), val);
+  for (size_t i = 0; i < 1000; i++) vec.erase(vec.begin());
+  do_not_optimize(vec);
+  report(label, 2000, timer.elapsed());
+}
+
+static void test_relocation_growth(void) {
+  std::string str("a string long enough to live on the heap");
+
+  bench_growth<ft::vector<int> >("ft::vector<int> push_back", 42);
+  bench_growth<std::vector<int> >("std::vector<int> push_back", 42);
+  bench_growth<ft::vector<Blob> >("ft::vector<Blob64> push_back", Blob());
+  bench_growth<std::vector<Blob> >("std::vector<Blob64> push_back", Blob());
+  bench_growth<ft::vector<Handle<false> > >("ft::vector<Handle> push_back (per element)", Handle<false>());
+  bench_growth<ft::vector<Handle<true> > >("ft::vector<Handle> push_back (opt-in memcpy)", Handle<true>());
+  bench_growth<ft::vector<std::string> >("ft::vector<std::string> push_back", str);
+  bench_growth<std::vector<std::string> >("std::vector<std::string> push_back", str);
+}
+
+static void test_relocation_insert_erase(void) {
+  bench_front_insert_erase<ft::vector<int> >("ft::vector<int> front insert/erase", 42);
+  bench_front_insert_erase<std::vector<int> >("std::vector<int> front insert/erase", 42);
+  bench_front_insert_erase<ft::vector<Handle<false> > >("ft::vector<Handle> front insert/erase (per element)", Handle<false>());
+  bench_front_insert_erase<ft::vector<Handle<true> > >("ft::vector<Handle> front insert/erase (opt-in)", Handle<true>());
+}
+
+template <class Growth>
+static void bench_policy(const std::string &name) {
+  typedef ft::vector<int, counting_allocator<int>, Growth> vector_type;
+
+  alloc_stats::reset();
+  bench_timer timer;
+  {
+    vector_type vec;
+    for (size_t i = 0; i < bench_count; i++) vec.push_back(i);
+    do_not_optimize(vec);
+  }
+  double ms = timer.elapsed();
+  report(name + " push_back", bench_count, ms);
+  std::cout << "    reallocations: " << alloc_stats::allocations << ", peak memory: " << alloc_stats::peak_bytes / 1024 << " KiB\n";
+
+  alloc_stats::reset();
+  timer.reset();
+  {
+    vector_type vec;
+    for (size_t i = 0; i < bench_count / 16; i++) vec.insert(vec.end(), 16, i);
+    do_not_optimize(vec);
+  }
+  ms = timer.elapsed();
+  report(name + " insert(end, 16, val)", bench_count, ms);
+  std::cout << "    reallocations: " << alloc_stats::allocations << ", peak memory: " << alloc_stats::peak_bytes / 1024 << " KiB\n";
+}
+
+static void test_growth_policies(void) {
+  bench_policy<ft::doubling_growth>("doubling");
+  bench_policy<ft::one_and_half_growth>("1.5x");
+  bench_policy<ft::page_growth<> >("page rounded");
+  bench_policy<ft::fixed_growth<4096> >("fixed +4096");
+  bench_policy<ft::huge_page_growth<> >("huge page");
+}
+
+template <class Vector>
+static void bench_buffer_growth(const std::string &label) {
+  const size_t count = bench_count / 16;  // 4 KiB each, 256 MiB for the default count
+
+  bench_timer timer;
+  {
+    Vector vec;
+    for (size_t i = 0; i < count; i++) vec.push_back(Buffer());
+    do_not_optimize(vec);
+  }
+  report(label, count, timer.elapsed());
+}
+
+static void test_mapped_growth(void) {
+  bench_buffer_growth<ft::vector<Buffer> >("ft::vector<Buffer> push_back (mremap)");
+  bench_buffer_growth<ft::vector<Buffer, counting_allocator<Buffer> > >("ft::vector<Buffer> push_back (allocator)");
+  bench_buffer_growth<std::vector<Buffer> >("std::vector<Buffer> push_back");
+}
+
+template <class Vector>
+static void bench_small_sizes(const std::string &label, size_t elements) {
+  const size_t rounds = bench_count / 4;
+  long         sum = 0;
+
+  bench_timer timer;
+  for (size_t round = 0; round < rounds; round++) {
+    Vector vec;
+    for (size_t i = 0; i < elements; i++) vec.push_back(i + round);
+    sum += vec[elements / 2];
+  }
+  do_not_optimize(sum);
+  report(label, rounds, timer.elapsed());
+}
+
+static void test_small_vector(void) {
+  const size_t sizes[] = {1, 4, 8, 15, 16, 32};
+
+  for (size_t idx = 0; idx < sizeof(sizes) / sizeof(*sizes); idx++) {
+    std::string n = std::string(" x") + char('0' + sizes[idx] / 10) + char('0' + sizes[idx] % 10);
+
+    bench_small_sizes<ft::vector<int> >("ft::vector<int>" + n, sizes[idx]);
+    bench_small_sizes<ft::small_vector<int, 16> >("ft::small_vector<int, 16>" + n, sizes[idx]);
+    bench_small_sizes<std::vector<int> >("std::vector<int>" + n, sizes[idx]);
+  }
+}
+
+template <class Vector>
+static void bench_move_heavy(const std::string &label, const typename Vector::value_type &val) {
+  const size_t count = bench_count / 10;
+
+  bench_timer timer;
+  {
+    Vector vec;
+    for (size_t i = 0; i < count; i++) vec.push_back(typename Vector::value_type(val));  // a temporary, moved in c++11
+    for (size_t i = 0; i < 100; i++) vec.insert(vec.begin(), typename Vector::value_type(val));
+    do_not_optimize(vec);
+  }
+  report(label, count + 100, timer.elapsed());
+}
+
+static void test_move_semantics(void) {
+  std::string str("a string long enough to live on the heap");
+
+  std::cout << "built with " << (FT_CXX11 ? "c++11 (move)" : "c++98 (copy)") << '\n';
+  bench_move_heavy<ft::vector<std::string> >("ft::vector<std::string> push_back + insert", str);
+  bench_move_heavy<std::vector<std::string> >("std::vector<std::string> push_back + insert", str);
+  bench_move_heavy<ft::vector<ft::vector<int> > >("ft::vector<ft::vector<int> > push_back + insert", ft::vector<int>(64, 1));
+  bench_move_heavy<std::vector<std::vector<int> > >("std::vector<std::vector<int> > push_back + insert", std::vector<int>(64, 1));
+
+  bench_timer timer;
+  {
+    ft::stack<std::string> stack;
+    for (size_t i = 0; i < bench_count / 10; i++) stack.push(std::string(str));
+    do_not_optimize(stack);
+  }
+  report("ft::stack<std::string> push", bench_count / 10, timer.elapsed());
+}
+
+void vector_bench(void) {
+  start_bench("Bench relocation growth", test_relocation_growth);
+  start_bench("Bench relocation insert/erase", test_relocation_insert_erase);
+  start_bench("Bench growth policies", test_growth_policies);
+  start_bench("Bench mapped growth", test_mapped_growth);
+  start_bench("Bench small_vector", test_small_vector);
+  start_bench("Bench move semantics", test_move_semantics);
+}
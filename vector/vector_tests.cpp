@@ -1,5 +1,18 @@
 #include "tests.hpp"
 
+// std has no growth policies, the std build runs the same sequence on std::vector
+#if STD
+typedef std::vector<int> one_and_half_ints;
+typedef std::vector<int> page_ints;
+typedef std::vector<int> fixed_ints;
+typedef std::vector<int> huge_page_ints;
+#else
+typedef ft::vector<int, std::allocator<int>, ft::one_and_half_growth>     one_and_half_ints;
+typedef ft::vector<int, std::allocator<int>, ft::page_growth<64> >        page_ints;
+typedef ft::vector<int, std::allocator<int>, ft::fixed_growth<3> >        fixed_ints;
+typedef ft::vector<int, std::allocator<int>, ft::huge_page_growth<256> > huge_page_ints;
+#endif
+
 static void test_constructor(void) {
     // constructors used in the same order as described above:
     ft::vector<int> first;                                // empty vector of ints
@@ -373,6 +386,133 @@ static void test_non_member_swap(void) {
     std::cout << '\n';
 }
 
+static void print_strings(const char *name, const ft::vector<std::string> &vec) {
+    std::cout << name << " contains:";
+    for (ft::vector<std::string>::const_iterator it = vec.begin(); it != vec.end(); ++it) std::cout << ' ' << *it;
+    std::cout << '\n';
+}
+
+static void test_non_trivial_elements(void) {
+    ft::vector<std::string> words;
+
+    for (int i = 0; i < 20; i++) words.push_back(std::string(i + 1, 'a' + i));  // several growths
+    words.insert(words.begin(), "front");
+    words.insert(words.begin() + 3, 2, "twice");
+    ft::vector<std::string> more(2, "more");
+    words.insert(words.end(), more.begin(), more.end());
+    words.erase(words.begin() + 5);
+    words.erase(words.begin() + 10, words.begin() + 15);
+    words.pop_back();
+    print_strings("words", words);
+
+    ft::vector<std::string> copy(words);
+    ft::vector<std::string> small(2, "small");
+    ft::vector<std::string> big(40, "big");
+    small = copy;  // grows
+    big = copy;    // shrinks
+    copy.clear();
+    print_strings("small", small);
+    print_strings("big", big);
+    std::cout << "copy size: " << copy.size() << '\n';
+}
+
+// the pushed element is one of the vector's own, the vector is full so it grows first
+static void test_self_push_back(void) {
+    ft::vector<std::string> words(1, "self");
+
+    for (int i = 0; i < 5; i++) words.push_back(words[i]);
+    words.push_back(words.back());
+    print_strings("words", words);
+}
+
+// the reserved slots past size() are raw memory, assign has to construct them
+static void test_assign_reserved(void) {
+    ft::vector<std::string> filled;
+    filled.reserve(4);
+    filled.assign(2, std::string(40, 'x'));
+    filled.assign(3, "fill");
+    filled.assign(1, "one");
+    print_strings("filled", filled);
+
+    std::string             words[] = {"first", std::string(40, 'y'), "third"};
+    ft::vector<std::string> ranged;
+    ranged.reserve(4);
+    ranged.assign(words, words + 2);
+    ranged.assign(words, words + 3);
+    print_strings("ranged", ranged);
+    ranged.assign(words + 2, words + 3);
+    print_strings("ranged", ranged);
+}
+
+static void test_large_growth(void) {
+    ft::vector<long> big;
+
+    for (long i = 0; i < 1000000; i++) big.push_back(i);  // crosses the mapped storage threshold
+    big.insert(big.begin() + 10, 5, -1);
+    big.erase(big.begin(), big.begin() + 5);
+
+    ft::vector<long> copy(big);
+    ft::vector<long> other;
+    other = big;
+    other.swap(big);
+
+    long sum = 0;
+    for (ft::vector<long>::iterator it = copy.begin(); it != copy.end(); ++it) sum += *it;
+    std::cout << "size: " << copy.size() << ", sum: " << sum << ", back: " << big.back() << '\n';
+    std::cout << "capacity: " << copy.capacity() << '\n';
+}
+
+// the capacities differ between the policies, only the contents & the size are printed
+template <class Vector>
+static void test_growth_policy(void) {
+    Vector vec;
+
+    for (int i = 0; i < 100; i++) vec.push_back(i);
+    vec.insert(vec.begin() + 10, 50, -1);
+    Vector more(30, 7);
+    vec.insert(vec.begin() + 5, more.begin(), more.end());
+    int tail[] = {-2, -3, -4};
+    vec.insert(vec.end(), tail, tail + 3);
+    vec.resize(400, 9);
+    vec.resize(150);
+
+    std::cout << "vec contains:";
+    for (typename Vector::iterator it = vec.begin(); it != vec.end(); ++it) std::cout << ' ' << *it;
+    std::cout << '\n';
+    std::cout << "size: " << vec.size() << '\n';
+}
+
+#if __cplusplus >= 201103L
+static void test_move_semantics(void) {
+    ft::vector<std::string> words;
+    std::string             word("moved");
+
+    words.push_back(std::move(word));
+    words.emplace_back(3, 'x');
+    words.emplace(words.begin(), "first");
+    words.insert(words.begin() + 1, std::string("second"));
+    print_strings("words", words);
+
+    ft::vector<std::string> self(1, "self");
+    self.emplace_back(self[0]);  // full : the argument is one of the elements the growth relocates
+    self.emplace_back(self.back());
+    self.emplace_back(self[1], 0, 2);
+    print_strings("self", self);
+
+    ft::vector<std::string> stolen(std::move(words));
+    print_strings("stolen", stolen);
+    std::cout << "words size: " << words.size() << '\n';
+
+    words = std::move(stolen);
+    print_strings("words", words);
+
+    ft::stack<ft::vector<int> > stack;
+    stack.push(ft::vector<int>(3, 42));
+    stack.emplace(2, 7);
+    std::cout << "stack top size: " << stack.top().size() << ", stack size: " << stack.size() << '\n';
+}
+#endif
+
 void vector_main() {
     start_test("Test Constructor", test_constructor);
     start_test("Test Assignment Operator", test_assignment_operator);
@@ -397,4 +537,15 @@ void vector_main() {
     start_test("Test get_allocator", test_get_allocator);
     start_test("Test relational operators", test_relational_operators);
     start_test("Test non-member swap", test_non_member_swap);
+    start_test("Test non trivial elements", test_non_trivial_elements);
+    start_test("Test self push_back", test_self_push_back);
+    start_test("Test assign reserved", test_assign_reserved);
+    start_test("Test large growth", test_large_growth);
+    start_test("Test one and half growth", test_growth_policy<one_and_half_ints>);
+    start_test("Test page growth", test_growth_policy<page_ints>);
+    start_test("Test fixed growth", test_growth_policy<fixed_ints>);
+    start_test("Test huge page growth", test_growth_policy<huge_page_ints>);
+#if __cplusplus >= 201103L
+    start_test("Test move semantics", test_move_semantics);
+#endif
 }
\ No newline at end of file